@@ -34,6 +34,7 @@ ZEBinaryBuilder::ZEBinaryBuilder(
     metadata.maxHwRevisionId = plat.usRevId;
     metadata.generatorId = TargetMetadata::GeneratorId::IGC;
     mBuilder.setTargetMetadata(metadata);
+    mBuilder.setCompressDebugSections(IGC_IS_FLAG_ENABLED(CompressDebugSections));
 
     addProgramScopeInfo(programInfo);
 
@@ -5524,7 +5524,11 @@ namespace IGC
 
         void* dbgInfo = nullptr;
         unsigned int dbgSize = 0;
-        if (context->m_instrTypes.hasDebugInfo || m_enableVISAdump)
+        // When the DWARF emitter runs, it takes the debug info in vISA's
+        // in-memory form and the binary form is only produced for dumps.
+        DebugInfoData& dbgInfoData = m_program->GetDebugInfoData();
+        const bool emitsDwarf = dbgInfoData.m_pDebugEmitter != nullptr;
+        if ((context->m_instrTypes.hasDebugInfo && !emitsDwarf) || m_enableVISAdump)
         {
             void* genxdbgInfo = nullptr;
             V(pMainKernel->GetGenxDebugInfo(genxdbgInfo, dbgSize));
@@ -5553,12 +5557,24 @@ namespace IGC
                 }
             }
 
-            dbgInfo = IGC::aligned_malloc(dbgSize, sizeof(void*));
+            if (!emitsDwarf)
+            {
+                dbgInfo = IGC::aligned_malloc(dbgSize, sizeof(void*));
 
-            memcpy_s(dbgInfo, dbgSize, genxdbgInfo, dbgSize);
+                memcpy_s(dbgInfo, dbgSize, genxdbgInfo, dbgSize);
+            }
+            else
+            {
+                dbgSize = 0;
+            }
 
             freeBlock(genxdbgInfo);
         }
+        if (emitsDwarf)
+        {
+            // must follow GetGenxDebugInfo which serializes from it
+            V(pMainKernel->TakeGenxDebugInfo(dbgInfoData.m_VISADebugInfo));
+        }
 
         pOutput->m_programBin = kernel;
         pOutput->m_programSize = size + padding;
@@ -65,6 +65,7 @@ namespace IGC {
         IGC_INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
         IGC_INITIALIZE_PASS_DEPENDENCY(PostDominatorTreeWrapperPass)
         IGC_INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+        IGC_INITIALIZE_PASS_DEPENDENCY(RegisterEstimator)
         IGC_INITIALIZE_PASS_END(CodeSinking, PASS_FLAG, PASS_DESCRIPTION, PASS_CFG_ONLY, PASS_ANALYSIS)
 
         CodeSinking::CodeSinking(bool generalSinking) : FunctionPass(ID) {
@@ -219,6 +220,16 @@ namespace IGC {
         LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
         DL = &F.getParent()->getDataLayout();
 
+        // RPE must be queried before any code motion, as liveness is keyed
+        // on the IR as it was when the analysis ran.
+        m_fatLoopsByRPE = generalCodeSinking &&
+            IGC_IS_FLAG_ENABLED(EnableLoopSinkRPE) &&
+            !LI->empty();
+        if (m_fatLoopsByRPE)
+        {
+            findFatLoopsByRPE(F);
+        }
+
         bool changed = hoistCongruentPhi(F);
 
         bool madeChange, everMadeChange = false;
@@ -255,7 +266,9 @@ namespace IGC {
             auto FatLoop = m_fatLoops[i];
             auto Pressure = m_fatLoopPressures[i];
             // Enable multiple-level loop sink if pressure is high enough
-            bool sinkMultiLevel = (Pressure > (2*ngrf + 2 * GRFThresholdDelta));
+            bool sinkMultiLevel = m_fatLoopsByRPE ?
+                (Pressure > (ngrf + GRFThresholdDelta)) :
+                (Pressure > (2*ngrf + 2 * GRFThresholdDelta));
             if (loopSink(FatLoop, sinkMultiLevel)) {
                 changed = true;
             }
@@ -328,6 +341,65 @@ namespace IGC {
         return pressure;
     }
 
+    // Use the register estimator to find loops whose max GRF pressure is
+    // beyond what the thread has, i.e. loops that will likely spill unless
+    // loop invariants are moved back into them.
+    void CodeSinking::findFatLoopsByRPE(Function& F)
+    {
+        RegisterEstimator* RPE = &getAnalysis<RegisterEstimator>();
+        if (RPE->hasNoGRFPressure())
+        {
+            return;
+        }
+        RPE->calculate();
+
+        // The SIMD width is not chosen yet. Use the required sub-group size
+        // if there is one, otherwise assume the widest, as WIAnalysis does.
+        uint16_t simdSize = 32;
+        if (CTX->type == ShaderType::OPENCL_SHADER)
+        {
+            IGCMD::MetaDataUtils* pMdUtils = CTX->getMetaDataUtils();
+            auto funcInfo = pMdUtils->findFunctionsInfoItem(&F);
+            if (funcInfo != pMdUtils->end_FunctionsInfo())
+            {
+                IGCMD::SubGroupSizeMetaDataHandle subGroupSize = funcInfo->second->getSubGroupSize();
+                if (subGroupSize->hasValue() && subGroupSize->getSIMD_size() >= 8)
+                {
+                    simdSize = (uint16_t)subGroupSize->getSIMD_size();
+                }
+            }
+        }
+
+        uint32_t ngrf = CTX->getNumGRFPerThread();
+        SmallPtrSet<Loop*, 8> fatLoops;
+        for (Loop* L : LI->getLoopsInPreorder())
+        {
+            if (!L->getLoopPreheader())
+                continue;
+
+            // Sinking into a fat loop already reaches the loops nested in it.
+            bool inFatLoop = false;
+            for (Loop* P = L->getParentLoop(); P && !inFatLoop; P = P->getParentLoop())
+            {
+                inFatLoop = fatLoops.count(P) != 0;
+            }
+            if (inFatLoop)
+                continue;
+
+            uint32_t maxPressure = 0;
+            for (BasicBlock* BB : L->blocks())
+            {
+                maxPressure = std::max(maxPressure, RPE->getMaxLiveGRFAtBB(BB, simdSize));
+            }
+            if (maxPressure > ngrf)
+            {
+                fatLoops.insert(L);
+                m_fatLoopPressures.push_back(maxPressure);
+                m_fatLoops.push_back(L);
+            }
+        }
+    }
+
     Loop* CodeSinking::findLoopAsPreheader(BasicBlock& blk)
     {
         // look through the successors
@@ -354,7 +426,8 @@ namespace IGC {
             pressure0 = EstimateLiveOutPressure(&blk, DL);
             uint32_t GRFThresholdDelta = IGC_GET_FLAG_VALUE(LoopSinkThresholdDelta);
             uint32_t ngrf = CTX->getNumGRFPerThread();
-            if (pressure0 > (2*ngrf + GRFThresholdDelta) &&
+            if (!m_fatLoopsByRPE &&
+                pressure0 > (2*ngrf + GRFThresholdDelta) &&
                 CTX->type == ShaderType::OPENCL_SHADER)
             {
                 if (auto L = findLoopAsPreheader(blk))
@@ -18,6 +18,8 @@ See LICENSE.TXT for details.
 #include <llvm/Analysis/PostDominators.h>
 #include <llvm/Analysis/LoopInfo.h>
 #include "common/LLVMWarningsPop.hpp"
+#include "Compiler/CISACodeGen/RegisterEstimator.hpp"
+#include "common/igc_regkeys.hpp"
 
 namespace IGC {
 
@@ -32,7 +34,9 @@ namespace IGC {
     public:
         static char ID; // Pass identification
 
-        CodeSinking(bool generalSinking = false);
+        // Every pipeline asks for general sinking; default to it so that
+        // igc_opt runs the pass the same way.
+        CodeSinking(bool generalSinking = true);
 
         virtual bool runOnFunction(llvm::Function& F) override;
 
@@ -42,6 +46,12 @@ namespace IGC {
             AU.addRequired<llvm::PostDominatorTreeWrapperPass>();
             AU.addRequired<llvm::LoopInfoWrapperPass>();
             AU.addRequired<CodeGenContextWrapper>();
+            // RPE is only needed by the pressure-driven loop sink; don't pay
+            // for building value ids when it is off.
+            if (IGC_IS_FLAG_ENABLED(EnableLoopSinkRPE))
+            {
+                AU.addRequired<RegisterEstimator>();
+            }
             AU.addPreserved<llvm::DominatorTreeWrapperPass>();
             AU.addPreserved<llvm::PostDominatorTreeWrapperPass>();
             AU.addPreserved<llvm::LoopInfoWrapperPass>();
@@ -83,6 +93,11 @@ namespace IGC {
         // out of the loop.
         std::vector<llvm::Loop*> m_fatLoops;
         std::vector<uint32_t> m_fatLoopPressures;
+        // True if fat loops are found by RegisterEstimator, in which case
+        // m_fatLoopPressures is the max number of live GRFs in the loop
+        // rather than the preheader live-out size in bytes.
+        bool m_fatLoopsByRPE = false;
+        void findFatLoopsByRPE(llvm::Function& F);
 
         // try to hoist phi nodes with congruent incoming values
         typedef std::pair<llvm::Instruction*, llvm::Instruction*> InstPair;
@@ -14,6 +14,10 @@ SPDX-License-Identifier: MIT
 #include "DebugInfo/DwarfDebug.hpp"
 #include "Compiler/CISACodeGen/DebugInfo.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace llvm;
 using namespace IGC;
 using namespace IGC::IGCMD;
@@ -74,6 +78,13 @@ bool DebugInfoPass::runOnModule(llvm::Module& M)
     }
 
     DwarfDISubprogramCache DISPCache;
+    // Emitters of the kernels whose DWARF is complete, in the order of the
+    // kernels. Their ELF files are written once there is one for each writing
+    // thread, so that no more emitters than that are kept alive.
+    std::vector<std::pair<CShader*, IDebugEmitter*>> finalizedEmitters;
+    unsigned numThreads = IGC_GET_FLAG_VALUE(DebugInfoEmitThreads);
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
 
     for (auto& currShader : units)
     {
@@ -85,12 +96,16 @@ bool DebugInfoPass::runOnModule(llvm::Module& M)
             continue;
 
         bool finalize = false;
+        bool complete = false;
         unsigned int size = m_currShader->GetDebugInfoData().m_VISAModules.size();
         m_pDebugEmitter = m_currShader->GetDebugInfoData().m_pDebugEmitter;
         std::vector<std::pair<unsigned int, std::pair<llvm::Function*, IGC::VISAModule*>>> sortedVISAModules;
 
         // Sort modules in order of their placement in binary
-        DbgDecoder decodedDbg(m_currShader->ProgramOutput()->m_debugDataGenISA);
+        auto& visaDbgInfo = m_currShader->GetDebugInfoData().m_VISADebugInfo;
+        DbgDecoder decodedDbg = visaDbgInfo.empty() ?
+            DbgDecoder(m_currShader->ProgramOutput()->m_debugDataGenISA) :
+            DbgDecoder(std::move(visaDbgInfo));
         auto getGenOff = [&decodedDbg](std::vector<std::pair<unsigned int, unsigned int>>& data, unsigned int VISAIndex)
         {
             unsigned retval = 0;
@@ -222,33 +237,86 @@ bool DebugInfoPass::runOnModule(llvm::Module& M)
             if (--size == 0)
                 finalize = true;
 
-            EmitDebugInfo(finalize, &decodedDbg);
+            complete = m_pDebugEmitter->EmitDwarf(finalize, &decodedDbg);
         }
 
         // set VISA dbg info to nullptr to indicate 1-step debug is enabled
         currShader->ProgramOutput()->m_debugDataGenISASize = 0;
         currShader->ProgramOutput()->m_debugDataGenISA = nullptr;
 
-        if (finalize)
+        if (complete)
+        {
+            finalizedEmitters.push_back(std::make_pair(m_currShader, m_pDebugEmitter));
+            if (finalizedEmitters.size() == numThreads)
+            {
+                WriteElfFiles(finalizedEmitters, numThreads);
+                finalizedEmitters.clear();
+            }
+        }
+        else if (finalize)
         {
             IDebugEmitter::Release(m_pDebugEmitter);
         }
     }
 
+    WriteElfFiles(finalizedEmitters, numThreads);
+
     return false;
 }
 
-void DebugInfoPass::EmitDebugInfo(bool finalize, DbgDecoder* decodedDbg)
+void DebugInfoPass::WriteElfFiles(const std::vector<std::pair<CShader*, IDebugEmitter*>>& emitters, unsigned numThreads)
 {
-    IGC_ASSERT(m_pDebugEmitter);
+    if (emitters.empty())
+        return;
+
+    // Writing the ELF file (MC layout, relocations, optional compression)
+    // touches nothing but the emitter's own MC objects, so the kernels are
+    // written on worker threads. Every buffer is stored to its own kernel
+    // afterwards, in the order of the kernels.
+    CodeGenContext* ctx = emitters.front().first->GetContext();
+    COMPILER_TIME_START(ctx, TIME_CG_DebugInfoElf);
 
-    std::vector<char> buffer = m_pDebugEmitter->Finalize(finalize, decodedDbg);
+    std::vector<std::vector<char>> buffers(emitters.size());
+    numThreads = (unsigned)std::min<size_t>(numThreads, emitters.size());
 
+    if (numThreads <= 1)
+    {
+        for (size_t i = 0; i < emitters.size(); ++i)
+            buffers[i] = emitters[i].second->WriteElf();
+    }
+    else
+    {
+        std::atomic<size_t> next(0);
+        auto writeElfs = [&emitters, &buffers, &next]()
+        {
+            for (size_t i = next++; i < emitters.size(); i = next++)
+                buffers[i] = emitters[i].second->WriteElf();
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < numThreads; ++i)
+            workers.emplace_back(writeElfs);
+        writeElfs();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    for (size_t i = 0; i < emitters.size(); ++i)
+    {
+        StoreDebugInfo(emitters[i].first, buffers[i]);
+        IDebugEmitter::Release(emitters[i].second);
+    }
+
+    COMPILER_TIME_END(ctx, TIME_CG_DebugInfoElf);
+}
+
+void DebugInfoPass::StoreDebugInfo(CShader* pShader, const std::vector<char>& buffer)
+{
     if (!buffer.empty())
     {
         if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable) || IGC_IS_FLAG_ENABLED(ElfDumpEnable))
         {
-            std::string debugFileNameStr = IGC::Debug::GetDumpName(m_currShader, "elf");
+            std::string debugFileNameStr = IGC::Debug::GetDumpName(pShader, "elf");
             FILE* const elfFile = fopen(debugFileNameStr.c_str(), "wb+");
             if (nullptr != elfFile)
             {
@@ -262,7 +330,7 @@ void DebugInfoPass::EmitDebugInfo(bool finalize, DbgDecoder* decodedDbg)
     if (dbgInfo)
         memcpy_s(dbgInfo, buffer.size(), buffer.data(), buffer.size());
 
-    SProgramOutput* pOutput = m_currShader->ProgramOutput();
+    SProgramOutput* pOutput = pShader->ProgramOutput();
     pOutput->m_debugData = dbgInfo;
     pOutput->m_debugDataSize = dbgInfo ? buffer.size() : 0;
 }
@@ -52,7 +52,8 @@ namespace IGC
             AU.setPreservesAll();
         }
 
-        void EmitDebugInfo(bool, DbgDecoder*);
+        void WriteElfFiles(const std::vector<std::pair<CShader*, IDebugEmitter*>>&, unsigned numThreads);
+        void StoreDebugInfo(CShader*, const std::vector<char>&);
     };
 
     class CatchAllLineNumber : public llvm::FunctionPass
@@ -16,6 +16,8 @@ SPDX-License-Identifier: MIT
 #include "llvm/IR/Function.h"
 #include "common/LLVMWarningsPop.hpp"
 
+#include "visa/include/VISADebugInfo.h"
+
 #include <unordered_set>
 
 using namespace llvm;
@@ -39,6 +41,9 @@ namespace IGC
         llvm::DenseMap<const llvm::Function*, llvm::DenseMap<llvm::Value*, CVariable*>> m_FunctionSymbols;
         CShader* m_pShader = nullptr;
         IDebugEmitter* m_pDebugEmitter = nullptr;
+        // Debug info of the compiled kernel handed over by vISA,
+        // consumed by DebugInfoPass
+        vISA::GenDebugInfo m_VISADebugInfo;
 
         static void markOutputPrivateBase(CShader* pShader, IDebugEmitter* pDebugEmitter);
         static void markOutputVar(CShader* pShader, IDebugEmitter* pDebugEmitter, llvm::Instruction* pInst, const char* pMetaDataName);
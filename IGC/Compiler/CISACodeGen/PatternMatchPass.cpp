@@ -119,8 +119,11 @@ namespace IGC
         // pattern match will update liveness held by LiveVar, which needs
         // WIAnalysis result for uniform variable
         m_LivenessInfo = &getAnalysis<LiveVarsAnalysis>().getLiveVars();
+
+        COMPILER_TIME_START(m_ctx, TIME_CG_PatternMatch);
         CreateBasicBlocks(&F);
         CodeGenNode(DT->getRootNode());
+        COMPILER_TIME_END(m_ctx, TIME_CG_PatternMatch);
         return false;
     }
 
@@ -328,6 +331,9 @@ namespace IGC
         auto it = m_blockMap.find(bb);
         IGC_ASSERT(it != m_blockMap.end());
         SBasicBlock* block = it->second;
+        // At most one DAG is rooted at each instruction; reserve up front so
+        // the DAG list doesn't get reallocated while walking large blocks.
+        block->m_dags.reserve(bb->size());
 
         // loop through instructions bottom up
         for (I = instructionList.rbegin(), E = instructionList.rend(); I != E; ++I)
@@ -351,12 +357,13 @@ namespace IGC
     {
         m_numBlocks = pLLVMFunc->size();
         m_blocks = new SBasicBlock[m_numBlocks];
+        m_blockMap.reserve(m_numBlocks);
         uint i = 0;
         for (BasicBlock& bb : *pLLVMFunc)
         {
             m_blocks[i].id = i;
             m_blocks[i].bb = &bb;
-            m_blockMap.insert(std::pair<llvm::BasicBlock*, SBasicBlock*>(&bb, &m_blocks[i]));
+            m_blockMap.insert(std::make_pair(&bb, &m_blocks[i]));
             i++;
         }
     }
@@ -1155,7 +1162,7 @@ namespace IGC
             // Match inline asm
             if (I.isInlineAsm())
             {
-                if (getAnalysis<CodeGenContextWrapper>().getCodeGenContext()->m_DriverInfo.SupportInlineAssembly())
+                if (m_ctx->m_DriverInfo.SupportInlineAssembly())
                 {
                     match = MatchSingleInstruction(I);
                 }
@@ -16,6 +16,7 @@ SPDX-License-Identifier: MIT
 
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/IR/InstVisitor.h>
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/MapVector.h>
 #include <llvm/Analysis/LoopInfo.h>
@@ -273,7 +274,7 @@ namespace IGC
         bool                  m_rootIsSubspanUse;
         llvm::DenseSet<llvm::Value*>             m_subSpanUse;
         llvm::SmallPtrSet<llvm::Value*, 8>       m_forceIsolates;
-        std::map<llvm::BasicBlock*, SBasicBlock*> m_blockMap;
+        llvm::DenseMap<llvm::BasicBlock*, SBasicBlock*> m_blockMap;
         SBasicBlock* m_blocks;
         uint                  m_numBlocks;
         llvm::DenseMap<llvm::Instruction*, bool> m_IsSIMDConstExpr;
@@ -0,0 +1,130 @@
+;=========================== begin_copyright_notice ============================
+;
+; Copyright (C) 2021 Intel Corporation
+;
+; SPDX-License-Identifier: MIT
+;
+;============================ end_copyright_notice =============================
+
+; RUN: env IGC_EnableLoopSinkRPE=1 igc_opt --platformskl --inputcs "-code sinking" -S %s -o %t.ll
+; RUN: FileCheck %s --check-prefix=RPE --input-file=%t.ll
+; RUN: igc_opt --platformskl --inputcs "-code sinking" -S %s -o %t.nope.ll
+; RUN: FileCheck %s --check-prefix=NORPE --input-file=%t.nope.ll
+
+; The 40 invariants are live across the whole loop. With the other values live
+; there that is about 90 GRFs at SIMD16, which fits in 128, but about 180 at
+; SIMD32, the widest the shader may be compiled to. With EnableLoopSinkRPE the loop is found to be
+; fat and the invariants, which all read %y only, are sunk into it.
+
+; RPE-LABEL: preheader:
+; RPE-NOT:   fadd
+; RPE:       br label %loop
+; RPE-LABEL: loop:
+; RPE-COUNT-40: fadd float %y,
+
+; NORPE-LABEL: preheader:
+; NORPE-COUNT-40: fadd float %y,
+; NORPE:       br label %loop
+
+define void @fat_loop(float %y, i32 %n, float addrspace(1)* %out) {
+entry:
+  %skip = icmp sle i32 %n, 0
+  br i1 %skip, label %exit, label %preheader
+
+preheader:
+  %x0 = fadd float %y, 1.000000e+00
+  %x1 = fadd float %y, 2.000000e+00
+  %x2 = fadd float %y, 3.000000e+00
+  %x3 = fadd float %y, 4.000000e+00
+  %x4 = fadd float %y, 5.000000e+00
+  %x5 = fadd float %y, 6.000000e+00
+  %x6 = fadd float %y, 7.000000e+00
+  %x7 = fadd float %y, 8.000000e+00
+  %x8 = fadd float %y, 9.000000e+00
+  %x9 = fadd float %y, 1.000000e+01
+  %x10 = fadd float %y, 1.100000e+01
+  %x11 = fadd float %y, 1.200000e+01
+  %x12 = fadd float %y, 1.300000e+01
+  %x13 = fadd float %y, 1.400000e+01
+  %x14 = fadd float %y, 1.500000e+01
+  %x15 = fadd float %y, 1.600000e+01
+  %x16 = fadd float %y, 1.700000e+01
+  %x17 = fadd float %y, 1.800000e+01
+  %x18 = fadd float %y, 1.900000e+01
+  %x19 = fadd float %y, 2.000000e+01
+  %x20 = fadd float %y, 2.100000e+01
+  %x21 = fadd float %y, 2.200000e+01
+  %x22 = fadd float %y, 2.300000e+01
+  %x23 = fadd float %y, 2.400000e+01
+  %x24 = fadd float %y, 2.500000e+01
+  %x25 = fadd float %y, 2.600000e+01
+  %x26 = fadd float %y, 2.700000e+01
+  %x27 = fadd float %y, 2.800000e+01
+  %x28 = fadd float %y, 2.900000e+01
+  %x29 = fadd float %y, 3.000000e+01
+  %x30 = fadd float %y, 3.100000e+01
+  %x31 = fadd float %y, 3.200000e+01
+  %x32 = fadd float %y, 3.300000e+01
+  %x33 = fadd float %y, 3.400000e+01
+  %x34 = fadd float %y, 3.500000e+01
+  %x35 = fadd float %y, 3.600000e+01
+  %x36 = fadd float %y, 3.700000e+01
+  %x37 = fadd float %y, 3.800000e+01
+  %x38 = fadd float %y, 3.900000e+01
+  %x39 = fadd float %y, 4.000000e+01
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %preheader ], [ %i.next, %loop ]
+  %acc = phi float [ 0.000000e+00, %preheader ], [ %acc40, %loop ]
+  %acc1 = fmul float %acc, %x0
+  %acc2 = fmul float %acc1, %x1
+  %acc3 = fmul float %acc2, %x2
+  %acc4 = fmul float %acc3, %x3
+  %acc5 = fmul float %acc4, %x4
+  %acc6 = fmul float %acc5, %x5
+  %acc7 = fmul float %acc6, %x6
+  %acc8 = fmul float %acc7, %x7
+  %acc9 = fmul float %acc8, %x8
+  %acc10 = fmul float %acc9, %x9
+  %acc11 = fmul float %acc10, %x10
+  %acc12 = fmul float %acc11, %x11
+  %acc13 = fmul float %acc12, %x12
+  %acc14 = fmul float %acc13, %x13
+  %acc15 = fmul float %acc14, %x14
+  %acc16 = fmul float %acc15, %x15
+  %acc17 = fmul float %acc16, %x16
+  %acc18 = fmul float %acc17, %x17
+  %acc19 = fmul float %acc18, %x18
+  %acc20 = fmul float %acc19, %x19
+  %acc21 = fmul float %acc20, %x20
+  %acc22 = fmul float %acc21, %x21
+  %acc23 = fmul float %acc22, %x22
+  %acc24 = fmul float %acc23, %x23
+  %acc25 = fmul float %acc24, %x24
+  %acc26 = fmul float %acc25, %x25
+  %acc27 = fmul float %acc26, %x26
+  %acc28 = fmul float %acc27, %x27
+  %acc29 = fmul float %acc28, %x28
+  %acc30 = fmul float %acc29, %x29
+  %acc31 = fmul float %acc30, %x30
+  %acc32 = fmul float %acc31, %x31
+  %acc33 = fmul float %acc32, %x32
+  %acc34 = fmul float %acc33, %x33
+  %acc35 = fmul float %acc34, %x34
+  %acc36 = fmul float %acc35, %x35
+  %acc37 = fmul float %acc36, %x36
+  %acc38 = fmul float %acc37, %x37
+  %acc39 = fmul float %acc38, %x38
+  %acc40 = fmul float %acc39, %x39
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %store, label %loop
+
+store:
+  store float %acc40, float addrspace(1)* %out
+  br label %exit
+
+exit:
+  ret void
+}
@@ -32,6 +32,7 @@ See LICENSE.TXT for details.
 #include "llvm/MC/MCSymbol.h"
 #include "llvm/MC/MCValue.h"
 #include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/SourceMgr.h"
 #include "common/LLVMWarningsPop.hpp"
 
@@ -386,6 +387,15 @@ StreamEmitter::StreamEmitter(raw_pwrite_stream& outStream,
     m_pDataLayout = new DataLayout(dataLayout);
     m_pSrcMgr = new SourceMgr();
     m_pAsmInfo = new VISAMCAsmInfo(GetPointerSize());
+    // The ELF writer compresses either all .debug_* sections or none. With
+    // relocations, .debug_info has .rela.debug_info, which the consumer
+    // applies to the section contents in place, so leave them uncompressed.
+    if (StreamOptions.CompressDebugSections && !StreamOptions.EnableRelocation &&
+        llvm::zlib::isAvailable())
+    {
+        // .debug_* sections are written as SHF_COMPRESSED when it makes them smaller
+        m_pAsmInfo->setCompressDebugSections(DebugCompressionType::Z);
+    }
     m_pObjFileInfo = new MCObjectFileInfo();
 
     MCRegisterInfo* regInfo = nullptr;
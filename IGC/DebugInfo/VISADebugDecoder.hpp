@@ -16,6 +16,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 
 #include "Probe/Assertion.h"
+#include "visa/include/VISADebugInfo.h"
 
 #include <type_traits>
 #include <algorithm>
@@ -260,7 +261,11 @@ namespace IGC
 
         void readMappingMem(DbgDecoder::Mapping& mapping)
         {
-            uint32_t temp = read<uint32_t>(dbg);
+            setMappingMem(mapping, read<uint32_t>(dbg));
+        }
+
+        static void setMappingMem(DbgDecoder::Mapping& mapping, uint32_t temp)
+        {
             mapping.m.memoryOffset = (temp & 0x7fffffff);
             mapping.m.isBaseOffBEFP = (temp & 0x80000000);
         }
@@ -459,6 +464,150 @@ namespace IGC
             }
         }
 
+        // Conversion from the in-memory debug info of vISA. The result is
+        // the same as decoding the binary form vISA serializes it to.
+        static VarAlloc convertVarAlloc(const vISA::GenDbgVarAlloc& var)
+        {
+            DbgDecoder::VarAlloc data;
+
+            data.virtualType = (DbgDecoder::VarAlloc::VirtualVarType)var.virtualType;
+            data.physicalType = (DbgDecoder::VarAlloc::PhysicalVarType)var.physicalType;
+            if (var.isMemory())
+            {
+                uint32_t memOffset = (uint32_t)var.mapping.memoryOffset;
+                if (var.mapping.isAbs)
+                    memOffset |= 0x80000000;
+                setMappingMem(data.mapping, memOffset);
+            }
+            else if (data.physicalType == VarAlloc::PhyTypeAddress ||
+                data.physicalType == VarAlloc::PhyTypeFlag ||
+                data.physicalType == VarAlloc::PhyTypeGRF)
+            {
+                data.mapping.r.regNum = var.mapping.regNum;
+                data.mapping.r.subRegNum = var.mapping.subRegNum;
+            }
+            return data;
+        }
+
+        static void convertLiveIntervals(const std::vector<vISA::GenDbgLiveInterval>& lrs,
+            std::vector<LiveIntervalsVISA>& out)
+        {
+            out.reserve(lrs.size());
+            for (const auto& lr : lrs)
+            {
+                DbgDecoder::LiveIntervalsVISA lv;
+                lv.start = (uint16_t)lr.start;
+                lv.end = (uint16_t)lr.end;
+                lv.var = convertVarAlloc(lr.var);
+                out.push_back(lv);
+            }
+        }
+
+        static void convertLiveIntervals(const std::vector<vISA::GenDbgLiveInterval>& lrs,
+            std::vector<LiveIntervalGenISA>& out)
+        {
+            out.reserve(lrs.size());
+            for (const auto& lr : lrs)
+            {
+                DbgDecoder::LiveIntervalGenISA lv;
+                lv.start = lr.start;
+                lv.end = lr.end;
+                lv.var = convertVarAlloc(lr.var);
+                out.push_back(lv);
+            }
+        }
+
+        static void convertPhyRegSaveInfo(const std::vector<vISA::GenDbgPhyRegSaveInfoPerIP>& entries,
+            std::vector<PhyRegSaveInfoPerIP>& out)
+        {
+            out.reserve(entries.size());
+            for (const auto& entry : entries)
+            {
+                PhyRegSaveInfoPerIP phyRegSave;
+                phyRegSave.genIPOffset = entry.genIPOffset;
+                phyRegSave.numEntries = (uint16_t)entry.data.size();
+                phyRegSave.data.reserve(entry.data.size());
+                for (const auto& regInfo : entry.data)
+                {
+                    DbgDecoder::RegInfoMapping info;
+                    info.srcRegOff = regInfo.srcRegOff;
+                    info.numBytes = regInfo.numBytes;
+                    info.dstInReg = regInfo.dstInReg;
+                    if (info.dstInReg)
+                    {
+                        info.dst.r.regNum = regInfo.dst.regNum;
+                        info.dst.r.subRegNum = regInfo.dst.subRegNum;
+                    }
+                    else
+                    {
+                        // the binary form has no absolute bit here
+                        setMappingMem(info.dst, (uint32_t)regInfo.dst.memoryOffset);
+                    }
+                    phyRegSave.data.push_back(info);
+                }
+                out.push_back(std::move(phyRegSave));
+            }
+        }
+
+        void convert(vISA::GenDebugInfo& info)
+        {
+            numCompiledObj = (uint16_t)info.compiledObjs.size();
+            compiledObjs.reserve(info.compiledObjs.size());
+
+            for (auto& obj : info.compiledObjs)
+            {
+                DbgInfoFormat f;
+                f.kernelName = std::move(obj.kernelName);
+                f.relocOffset = obj.relocOffset;
+
+                f.CISAOffsetMap.reserve(obj.CISAOffsetMap.size());
+                for (const auto& item : obj.CISAOffsetMap)
+                    f.CISAOffsetMap.push_back(std::make_pair(item.first, f.relocOffset + item.second));
+
+                f.CISAIndexMap.reserve(obj.CISAIndexMap.size());
+                for (const auto& item : obj.CISAIndexMap)
+                    f.CISAIndexMap.push_back(std::make_pair(item.first, f.relocOffset + item.second));
+
+                f.Vars.resize(obj.Vars.size());
+                for (size_t j = 0; j != obj.Vars.size(); j++)
+                {
+                    f.Vars[j].name = std::move(obj.Vars[j].name);
+                    convertLiveIntervals(obj.Vars[j].lrs, f.Vars[j].lrs);
+                }
+
+                f.subs.resize(obj.subs.size());
+                for (size_t j = 0; j != obj.subs.size(); j++)
+                {
+                    f.subs[j].name = std::move(obj.subs[j].name);
+                    f.subs[j].startVISAIndex = obj.subs[j].startVISAIndex;
+                    f.subs[j].endVISAIndex = obj.subs[j].endVISAIndex;
+                    convertLiveIntervals(obj.subs[j].retval, f.subs[j].retval);
+                }
+
+                const auto& cfi = obj.cfi;
+                f.cfi.frameSize = cfi.frameSize;
+                f.cfi.befpValid = cfi.befpValid;
+                if (f.cfi.befpValid)
+                    convertLiveIntervals(cfi.befp, f.cfi.befp);
+                f.cfi.callerbefpValid = cfi.callerbefpValid;
+                if (f.cfi.callerbefpValid)
+                    convertLiveIntervals(cfi.callerbefp, f.cfi.callerbefp);
+                f.cfi.retAddrValid = cfi.retAddrValid;
+                if (f.cfi.retAddrValid)
+                    convertLiveIntervals(cfi.retAddr, f.cfi.retAddr);
+                f.cfi.numCalleeSaveEntries = (uint16_t)cfi.calleeSaveEntry.size();
+                convertPhyRegSaveInfo(cfi.calleeSaveEntry, f.cfi.calleeSaveEntry);
+                f.cfi.numCallerSaveEntries = (uint16_t)cfi.callerSaveEntry.size();
+                convertPhyRegSaveInfo(cfi.callerSaveEntry, f.cfi.callerSaveEntry);
+
+                compiledObjs.push_back(std::move(f));
+
+                // release vISA's copy as we go to keep a single copy alive
+                obj = vISA::GenDbgCompiledObj();
+            }
+            info.compiledObjs.clear();
+        }
+
     public:
         // TODO: we should pass the size too
         DbgDecoder(const void* buf) : dbg(buf)
@@ -467,6 +616,13 @@ namespace IGC
                 decode();
         }
 
+        // Take over the debug info vISA produced in memory, without the
+        // encode/decode round trip through the binary form
+        DbgDecoder(vISA::GenDebugInfo&& info) : dbg(nullptr)
+        {
+            convert(info);
+        }
+
         bool getVarInfo(std::string& kernelName, std::string& name, VarInfo& var) const
         {
             for (const auto& k : compiledObjs)
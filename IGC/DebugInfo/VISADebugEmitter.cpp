@@ -261,10 +261,18 @@ void DebugEmitter::SetDISPCache(DwarfDISubprogramCache *DISPCache) {
 }
 
 std::vector<char> DebugEmitter::Finalize(bool finalize, DbgDecoder* decodedDbg)
+{
+    if (!EmitDwarf(finalize, decodedDbg))
+        return {};
+
+    return WriteElf();
+}
+
+bool DebugEmitter::EmitDwarf(bool finalize, DbgDecoder* decodedDbg)
 {
     if (!m_debugEnabled)
     {
-        return {};
+        return false;
     }
 
     IGC_ASSERT_MESSAGE(m_pVISAModule, "active visa object must be selected before finalization");
@@ -286,20 +294,29 @@ std::vector<char> DebugEmitter::Finalize(bool finalize, DbgDecoder* decodedDbg)
     m_pDwarfDebug->endFunction(pFunc);
 
     if (!finalize)
-        return {};
+        return false;
 
     IGC_ASSERT(doneOnce);
 
     // Finalize debug information.
     m_pDwarfDebug->endModule();
 
-    m_pStreamEmitter->Finalize();
-
     LLVM_DEBUG(dbgs() << "Finalized Visa Module:\n");
     LLVM_DEBUG(m_pVISAModule->dump());
 
+    m_entryName = pFunc->getName().str();
+    m_is64Bit = m_pVISAModule->getPointerSize() == 8;
+    return true;
+}
+
+std::vector<char> DebugEmitter::WriteElf()
+{
+    IGC_ASSERT_MESSAGE(m_pStreamEmitter, "debug info must be emitted before writing the ELF");
+
+    m_pStreamEmitter->Finalize();
+
     // Add program header table to satisfy latest gdb
-    bool is64Bit = m_pVISAModule->getPointerSize() == 8;
+    bool is64Bit = m_is64Bit;
     unsigned int phtSize = sizeof(llvm::ELF::Elf32_Phdr);
     if (is64Bit)
         phtSize = sizeof(llvm::ELF::Elf64_Phdr);
@@ -307,7 +324,7 @@ std::vector<char> DebugEmitter::Finalize(bool finalize, DbgDecoder* decodedDbg)
     unsigned int kernelNameSizeWithDot = 0;
     if (m_pStreamEmitter->GetEmitterSettings().ZeBinCompatible)
     {
-        kernelNameSizeWithDot = sizeof('.') + pFunc->getName().size();
+        kernelNameSizeWithDot = sizeof('.') + m_entryName.size();
     }
     size_t elfWithProgramHeaderSize = m_str.size() + phtSize + kernelNameSizeWithDot;
     std::vector<char> Result(elfWithProgramHeaderSize);
@@ -324,7 +341,7 @@ std::vector<char> DebugEmitter::Finalize(bool finalize, DbgDecoder* decodedDbg)
         // How each elf section gets its name? Find the answer in the following function.
 
         size_t endOfDotTextNameOffset = 0;
-        std::string entryFunctionNameWithDot = "." + pFunc->getName().str();
+        std::string entryFunctionNameWithDot = "." + m_entryName;
         unsigned int kernelNameSizeWithDot = entryFunctionNameWithDot.size();
         prepareElfForZeBinary(is64Bit, m_str.begin(), m_str.size(), kernelNameSizeWithDot, &endOfDotTextNameOffset);
 
@@ -54,6 +54,8 @@ namespace IGC
         void SetDISPCache(DwarfDISubprogramCache *DISPCache) override;
 
         std::vector<char> Finalize(bool finalize, DbgDecoder* decodedDbg) override;
+        bool EmitDwarf(bool finalize, DbgDecoder* decodedDbg) override;
+        std::vector<char> WriteElf() override;
 
         void BeginInstruction(llvm::Instruction* pInst) override;
         void EndInstruction(llvm::Instruction* pInst) override;
@@ -87,6 +89,11 @@ namespace IGC
 
         unsigned int lastGenOff = 0;
 
+        // the entry function's name and pointer size, captured by EmitDwarf
+        // for WriteElf
+        std::string m_entryName;
+        bool m_is64Bit = false;
+
         void writeProgramHeaderTable(bool is64Bit, void* pBuffer, unsigned int size);
         void prepareElfForZeBinary(bool is64Bit, char* pElfBuffer, size_t elfBufferSize, size_t kernelNameWithDotSize,
             size_t* pEndOfDotTextNameInStrtab);
@@ -71,6 +71,20 @@ namespace IGC
         virtual std::vector<char>
             Finalize(bool finalize, DbgDecoder* decodedDbg) = 0;
 
+        /// @brief Emit debug info of the current function, same as Finalize
+        ///        except that the ELF file is not written. WriteElf has to be
+        ///        called once this returns true.
+        /// @param finalize [IN] indicates whether this is last function in group.
+        /// @param decodedDbg [IN] holds decoded VISA debug information.
+        /// @return true if the debug info is complete and the ELF can be written.
+        virtual bool EmitDwarf(bool finalize, DbgDecoder* decodedDbg) = 0;
+
+        /// @brief Write the ELF file and reset debug emitter. This does not
+        ///        access the LLVM IR, so emitters of different kernels can
+        ///        write their ELF files concurrently.
+        /// @return memory buffer which contains the emitted debug info.
+        virtual std::vector<char> WriteElf() = 0;
+
         /// @brief Process instruction before emitting its VISA code.
         /// @param pInst instruction to process.
         virtual void BeginInstruction(llvm::Instruction* pInst) = 0;
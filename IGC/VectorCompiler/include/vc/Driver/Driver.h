@@ -90,6 +90,8 @@ struct CompileOptions {
   bool DumpAsm = false;
   bool DumpDebugInfo = false;
   bool TimePasses = false;
+  // If not empty, timers are written there as JSON instead of stderr.
+  std::string TimePassesFile;
   bool ShowStats = false;
   std::string StatsFile;
   std::string LLVMOptions;
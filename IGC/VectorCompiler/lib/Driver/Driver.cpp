@@ -385,6 +385,21 @@ static vc::CompileOutput runCodeGen(const vc::CompileOptions &Opts,
   IGC_ASSERT_EXIT_MESSAGE(0, "Unknown runtime kind");
 }
 
+// Write all timers as a JSON object to the given file. Timers are reset
+// afterwards the same way TimerGroup::printAll does.
+static void printTimersJSON(StringRef Filename) {
+  std::error_code EC;
+  raw_fd_ostream TimerS(Filename, EC, llvm::sys::fs::OF_Text);
+  if (EC) {
+    llvm::errs() << Filename << ": " << EC.message() << "\n";
+  } else {
+    TimerS << "{";
+    TimerGroup::printAllJSONValues(TimerS, "");
+    TimerS << "\n}\n";
+  }
+  TimerGroup::printAll(llvm::nulls());
+}
+
 // Parse global llvm cl options.
 // Parsing of cl options should not fail under any circumstances.
 static void parseLLVMOptions(const std::string &Args) {
@@ -462,7 +477,10 @@ Expected<vc::CompileOutput> vc::Compile(ArrayRef<char> Input,
   vc::CompileOutput Output = runCodeGen(Opts, ExtData, TM, M);
 
   // Print timers if any and restore old TimePassesIsEnabled value.
-  TimerGroup::printAll(llvm::errs());
+  if (Opts.TimePassesFile.empty())
+    TimerGroup::printAll(llvm::errs());
+  else
+    printTimersJSON(Opts.TimePassesFile);
   TimePassesIsEnabled = TimePassesIsEnabledLocal;
 
   // Print LLVM statistics if required.
@@ -638,6 +656,9 @@ static Error fillInternalOptions(const opt::ArgList &InternalOptions,
     Opts.DumpAsm = true;
   if (InternalOptions.hasArg(OPT_ftime_report))
     Opts.TimePasses = true;
+  Opts.TimePassesFile = InternalOptions.getLastArgValue(OPT_ftime_report_file);
+  if (!Opts.TimePassesFile.empty())
+    Opts.TimePasses = true;
   if (InternalOptions.hasArg(OPT_print_stats))
     Opts.ShowStats = true;
   Opts.StatsFile = InternalOptions.getLastArgValue(OPT_stats_file);
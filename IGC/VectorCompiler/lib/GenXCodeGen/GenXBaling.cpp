@@ -21,6 +21,7 @@ SPDX-License-Identifier: MIT
 #include "GenXUtil.h"
 #include "Probe/Assertion.h"
 #include "llvm/ADT/DepthFirstIterator.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/InstructionSimplify.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -48,6 +49,9 @@ using namespace llvm;
 using namespace genx;
 using namespace GenXIntrinsic::GenXRegion;
 
+STATISTIC(NumInstsBaled, "Number of instructions baling was calculated for");
+STATISTIC(NumInstsRebaled, "Number of instructions rebaled incrementally");
+
 // set of debug options to switch off different baling types
 static cl::opt<bool> BaleBinary("bale-binary", cl::init(true), cl::Hidden,
                                 cl::desc("Bale binary operators"));
@@ -182,15 +186,46 @@ bool GenXBaling::processFunction(Function *F)
   return Changed;
 }
 
+/***********************************************************************
+ * rebaleInst : update baling for an instruction that a later pass has
+ *    inserted or whose operands it has changed
+ *
+ * The decision whether Inst is baled in is made when processing its user,
+ * so its single user (if any) is recalculated as well. This avoids having
+ * to invalidate and rerun the whole analysis for a local change.
+ *
+ * A baled in operand that has other uses, such as one Inst shares with the
+ * instruction it was cloned from, is cloned for Inst as processFunction
+ * does, so the bales of the other users are left as they are. The caller
+ * must not preserve liveness and numbering, which know nothing of the clone.
+ */
+void GenXBaling::rebaleInst(Instruction *Inst, DominatorTree *DomTree)
+{
+  ++NumInstsRebaled;
+  DT = DomTree;
+  processInst(Inst);
+  if (Inst->hasOneUse()) {
+    auto *User = cast<Instruction>(Inst->use_begin()->getUser());
+    if (!isa<PHINode>(User))
+      processInst(User);
+  }
+  for (auto i = TwoAddrSends.begin(), e = TwoAddrSends.end(); i != e; ++i)
+    processTwoAddrSend(*i);
+  TwoAddrSends.clear();
+  doClones();
+  DT = nullptr;
+}
+
 /***********************************************************************
  * processInst : calculate baling for an instruction
  *
- * Usually this is called from runOnFunction above. However another pass
- * can call this to recalculate the baling for an instruction, particularly
- * for a new instruction it has just added. GenXLegalization does this.
+ * Usually this is called from runOnFunction above. Another pass that has
+ * added or changed an instruction should use rebaleInst instead, which also
+ * updates the bale parent.
  */
 void GenXBaling::processInst(Instruction *Inst)
 {
+  ++NumInstsBaled;
   unsigned IntrinID = GenXIntrinsic::getAnyIntrinsicID(Inst);
   if (GenXIntrinsic::isWrRegion(IntrinID))
     processWrRegion(Inst);
@@ -400,6 +400,10 @@ public:
   bool processFunction(Function *F);
   // processInst : recalculate the baling info for an instruction
   void processInst(Instruction *Inst);
+  // rebaleInst : update baling info locally for an instruction inserted or
+  //   changed by a later pass, cloning any baled in operand it shares.
+  //   DomTree is the dominator tree of its function.
+  void rebaleInst(Instruction *Inst, DominatorTree *DomTree);
   // getBaleInfo : get BaleInfo for an instruction
   genx::BaleInfo getBaleInfo(const Instruction *Inst) const {
     InstMap_t::const_iterator i = InstMap.find(Inst);
@@ -195,6 +195,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Timer.h"
 
 #include <algorithm>
 #include <vector>
@@ -212,6 +213,9 @@ static cl::opt<bool> GenXCoalescingLessCopies(
 STATISTIC(NumCoalescingCandidates, "Number of coalescing candidates");
 STATISTIC(NumInsertedCopies, "Number of inserted copies");
 
+static const char TimerGroupName[] = "genx-coalescing";
+static const char TimerGroupDescription[] = "GenX Coalescing";
+
 // Diagnostic information for error/warning relating fast-composition.
 class DiagnosticInfoFastComposition : public DiagnosticInfo {
 private:
@@ -470,8 +474,12 @@ bool GenXCoalescing::runOnFunctionGroup(FunctionGroup &FG)
   visit(FG);
 
   // Process the copy coalescing candidates.
-  for (unsigned i = 0; i != CopyCandidates.size(); ++i)
-    processCopyCandidate(CopyCandidates[i]);
+  {
+    NamedRegionTimer T("copy", "Copy coalescing", TimerGroupName,
+                       TimerGroupDescription, TimePassesIsEnabled);
+    for (unsigned i = 0; i != CopyCandidates.size(); ++i)
+      processCopyCandidate(CopyCandidates[i]);
+  }
 
   // Record the call arg and return value pre-copy candidates.
   recordCallCandidates(&FG);
@@ -479,9 +487,13 @@ bool GenXCoalescing::runOnFunctionGroup(FunctionGroup &FG)
   // Sort the array of normal coalescing candidates (including phi ones) then
   // process them. Preserve original ordering for equal priority candidates
   // to get consistent results across different runs.
-  std::stable_sort(NormalCandidates.begin(), NormalCandidates.end());
-  for (unsigned i = 0; i != NormalCandidates.size(); ++i)
-    processCandidate(NormalCandidates[i]);
+  {
+    NamedRegionTimer T("normal", "Normal coalescing", TimerGroupName,
+                       TimerGroupDescription, TimePassesIsEnabled);
+    std::stable_sort(NormalCandidates.begin(), NormalCandidates.end());
+    for (unsigned i = 0; i != NormalCandidates.size(); ++i)
+      processCandidate(NormalCandidates[i]);
+  }
 
   // Now scan all phi nodes again, inserting copies where necessary. Doing
   // them in one go here ensures that the copies appear in the predecessor
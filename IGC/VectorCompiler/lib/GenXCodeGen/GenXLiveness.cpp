@@ -34,6 +34,7 @@ SPDX-License-Identifier: MIT
 #include "llvmWrapper/IR/Instructions.h"
 
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/DiagnosticInfo.h"
@@ -50,6 +51,8 @@ SPDX-License-Identifier: MIT
 using namespace llvm;
 using namespace genx;
 
+STATISTIC(NumInterferenceChecks, "Number of live range interference checks");
+
 SimpleValue::SimpleValue(const AssertingSV &ASV)
     : SimpleValue(ASV.getValue(), ASV.getIndex()) {}
 
@@ -561,8 +564,7 @@ void GenXLiveness::replaceValue(SimpleValue OldVal, SimpleValue NewVal)
  */
 LiveRange *GenXLiveness::getOrCreateLiveRange(SimpleValue V)
 {
-  LiveRangeMap_t::iterator i = LiveRangeMap.insert(
-      LiveRangeMap_t::value_type(V, 0)).first;
+  LiveRangeMap_t::iterator i = LiveRangeMap.insert({V, nullptr}).first;
   LiveRange *LR = i->second;
   if (!LR) {
     // Newly created map entry. Create the LiveRange for it.
@@ -946,6 +948,30 @@ bool GenXLiveness::twoAddrInterfere(LiveRange *LR1, LiveRange *LR2)
   return !SitesSet.empty();
 }
 
+/***********************************************************************
+ * skipSegmentsEndingBy : return the first segment in [I, E) that ends after
+ *      Pos
+ *
+ * Segments in a live range are sorted and disjoint, so this gallops forward
+ * and then binary searches. That keeps the common case of a neighbouring
+ * segment cheap while making a long run of segments of one live range that
+ * sit in a gap of the other one logarithmic instead of linear.
+ */
+static LiveRange::iterator skipSegmentsEndingBy(LiveRange::iterator I,
+                                                LiveRange::iterator E,
+                                                unsigned Pos) {
+  auto EndsBy = [Pos](const Segment &S) { return S.getEnd() <= Pos; };
+  size_t Step = 1;
+  while (I != E && EndsBy(*I)) {
+    size_t Left = std::distance(I, E);
+    if (Step >= Left || !EndsBy(I[Step]))
+      return std::partition_point(I, I + std::min(Step, Left), EndsBy);
+    I += Step;
+    Step <<= 1;
+  }
+  return I;
+}
+
 /***********************************************************************
  * getSingleInterferenceSites : check whether two live ranges interfere,
  *      returning single number interference sites
@@ -970,9 +996,16 @@ bool GenXLiveness::twoAddrInterfere(LiveRange *LR1, LiveRange *LR2)
 bool GenXLiveness::getSingleInterferenceSites(LiveRange *LR1, LiveRange *LR2,
     SmallVectorImpl<unsigned> *Sites)
 {
+  ++NumInterferenceChecks;
   // Swap if necessary to make LR1 the one with more segments.
   if (LR1->size() < LR2->size())
     std::swap(LR1, LR2);
+  if (!LR2->size())
+    return false;
+  // Disjoint hulls cannot overlap anywhere.
+  if (LR1->begin()->getStart() >= std::prev(LR2->end())->getEnd() ||
+      LR2->begin()->getStart() >= std::prev(LR1->end())->getEnd())
+    return false;
   auto Idx2 = LR2->begin(), End2 = LR2->end();
   // Find segment in LR1 that contains or is the next after the start
   // of the first segment in LR2, including the case that the start of
@@ -1001,12 +1034,15 @@ bool GenXLiveness::getSingleInterferenceSites(LiveRange *LR1, LiveRange *LR2,
           Sites->push_back(Idx1->getStart());
         }
     }
-    // Advance whichever one has the lowest End.
+    // Advance whichever one has the lowest End, skipping over any segments
+    // that end before the other one starts as they cannot overlap it.
     if (Idx1->getEnd() < Idx2->getEnd()) {
-      if (++Idx1 == End1)
+      Idx1 = skipSegmentsEndingBy(std::next(Idx1), End1, Idx2->getStart());
+      if (Idx1 == End1)
         return false;
     } else {
-      if (++Idx2 == End2)
+      Idx2 = skipSegmentsEndingBy(std::next(Idx2), End2, Idx1->getStart());
+      if (Idx2 == End2)
         return false;
     }
   }
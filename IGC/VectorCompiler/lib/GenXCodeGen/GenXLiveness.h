@@ -162,6 +162,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/ValueHandle.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/MapVector.h"
 #include <map>
@@ -474,9 +475,27 @@ public:
 
 } // end namespace genx
 
+// Specialize DenseMapInfo for SimpleValue.
+template <> struct DenseMapInfo<genx::SimpleValue> {
+  static inline genx::SimpleValue getEmptyKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
+  }
+  static inline genx::SimpleValue getTombstoneKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
+  }
+  static unsigned getHashValue(const genx::SimpleValue &SV) {
+    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
+           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
+  }
+  static bool isEqual(const genx::SimpleValue &LHS,
+                      const genx::SimpleValue &RHS) {
+    return LHS == RHS;
+  }
+};
+
 class GenXLiveness : public FunctionGroupPass {
   FunctionGroup *FG = nullptr;
-  using LiveRangeMap_t = std::map<genx::SimpleValue, genx::LiveRange *>;
+  using LiveRangeMap_t = DenseMap<genx::SimpleValue, genx::LiveRange *>;
   LiveRangeMap_t LiveRangeMap;
   std::unique_ptr<genx::CallGraph> CG;
   GenXBaling *Baling = nullptr;
@@ -625,24 +644,6 @@ private:
 
 void initializeGenXLivenessPass(PassRegistry &);
 
-// Specialize DenseMapInfo for SimpleValue.
-template <> struct DenseMapInfo<genx::SimpleValue> {
-  static inline genx::SimpleValue getEmptyKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
-  }
-  static inline genx::SimpleValue getTombstoneKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
-  }
-  static unsigned getHashValue(const genx::SimpleValue &SV) {
-    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
-           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
-  }
-  static bool isEqual(const genx::SimpleValue &LHS,
-                      const genx::SimpleValue &RHS) {
-    return LHS == RHS;
-  }
-};
-
 } // end namespace llvm
 namespace std {
 template <> struct hash<llvm::genx::Segment> {
@@ -31,6 +31,11 @@ SPDX-License-Identifier: MIT
 /// multiple bitcasts (from CM format()) or up to one SExt/ZExt (from a cast) in
 /// between.
 ///
+/// Long chains of nested wrregions (as produced for matrix tiles) are walked
+/// recursively from each wrregion in the chain. To keep that linear, the pass
+/// remembers the wrregions it has already found nothing to collapse for in the
+/// current sweep over a basic block.
+///
 //===----------------------------------------------------------------------===//
 #define DEBUG_TYPE "GENX_RegionCollapsing"
 
@@ -39,6 +44,7 @@ SPDX-License-Identifier: MIT
 #include "GenXRegion.h"
 #include "GenXUtil.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/InstructionSimplify.h"
 #include "llvm/IR/BasicBlock.h"
@@ -48,6 +54,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/ValueMap.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Transforms/Utils/Local.h"
@@ -58,13 +65,30 @@ SPDX-License-Identifier: MIT
 using namespace llvm;
 using namespace genx;
 
+STATISTIC(NumWrRegionWalks, "Number of wrregions walked for collapsing");
+STATISTIC(NumSettledWrRegionHits,
+          "Number of wrregion chain walks cut short by the memo");
+
 namespace {
 
+// Memo entries must not migrate to the replacement of a wrregion.
+struct SettledWrRegionConfig : ValueMapConfig<Instruction *> {
+  enum { FollowRAUW = false };
+};
+
+// Kinds of wrregion processing that can be memoized.
+enum SettledKind : unsigned { SettledCollapse = 1, SettledSplat = 2 };
+
 // GenX region collapsing pass
 class GenXRegionCollapsing : public FunctionPass {
   const DataLayout *DL = nullptr;
   DominatorTree *DT = nullptr;
   bool Modified = false;
+  // Wrregions found to have nothing to collapse in the current sweep over a
+  // basic block, as a mask of SettledKind. Cleared before each sweep; a sweep
+  // that changes anything is repeated, so the final sweep behaves exactly as
+  // it would without the memo.
+  ValueMap<Instruction *, unsigned, SettledWrRegionConfig> SettledWrRegions;
 public:
   static char ID;
   explicit GenXRegionCollapsing() : FunctionPass(ID) { }
@@ -83,7 +107,10 @@ private:
   Instruction *processWrRegionBitCast(Instruction *WrRegion);
   void processWrRegionBitCast2(Instruction *WrRegion);
   Instruction *processWrRegion(Instruction *OuterWr);
+  Instruction *processWrRegionImpl(Instruction *OuterWr);
   Instruction *processWrRegionSplat(Instruction *OuterWr);
+  Instruction *processWrRegionSplatImpl(Instruction *OuterWr);
+  bool isSettled(Instruction *Wr, SettledKind Kind) const;
   bool normalizeElementType(Region *R1, Region *R2, bool PreferFirst = false);
   bool combineRegions(const Region *OuterR, const Region *InnerR,
                       Region *CombinedR);
@@ -144,6 +171,7 @@ bool GenXRegionCollapsing::runOnFunction(Function &F)
     } while (Modified);
   }
 
+  SettledWrRegions.clear();
   return Changed;
 }
 
@@ -257,6 +285,7 @@ void GenXRegionCollapsing::runOnBasicBlock(BasicBlock *BB) {
   }
   Modified |= SimplifyInstructionsInBlock(BB);
 
+  SettledWrRegions.clear();
   // This loop processes instructions in reverse, tolerating an instruction
   // being removed during its processing, and not re-processing any new
   // instructions added during the processing of an instruction.
@@ -885,6 +914,18 @@ static bool isBitwiseIdentical(Value *V1, Value *V2, DominatorTree *DT) {
 Instruction *GenXRegionCollapsing::processWrRegion(Instruction *OuterWr)
 {
   IGC_ASSERT(OuterWr);
+  if (isSettled(OuterWr, SettledCollapse))
+    return OuterWr;
+  Instruction *Res = processWrRegionImpl(OuterWr);
+  if (Res == OuterWr)
+    SettledWrRegions[OuterWr] |= SettledCollapse;
+  return Res;
+}
+
+Instruction *GenXRegionCollapsing::processWrRegionImpl(Instruction *OuterWr)
+{
+  IGC_ASSERT(OuterWr);
+  ++NumWrRegionWalks;
   // Find the inner wrregion, skipping bitcasts.
   auto InnerWr = dyn_cast<Instruction>(
       OuterWr->getOperand(GenXIntrinsic::GenXRegion::NewValueOperandNum));
@@ -979,6 +1020,19 @@ Instruction *GenXRegionCollapsing::processWrRegion(Instruction *OuterWr)
 Instruction *GenXRegionCollapsing::processWrRegionSplat(Instruction *OuterWr)
 {
   IGC_ASSERT(OuterWr);
+  if (isSettled(OuterWr, SettledSplat))
+    return OuterWr;
+  Instruction *Res = processWrRegionSplatImpl(OuterWr);
+  if (Res == OuterWr)
+    SettledWrRegions[OuterWr] |= SettledSplat;
+  return Res;
+}
+
+Instruction *
+GenXRegionCollapsing::processWrRegionSplatImpl(Instruction *OuterWr)
+{
+  IGC_ASSERT(OuterWr);
+  ++NumWrRegionWalks;
   // Find the inner wrregion, skipping bitcasts.
   auto InnerWr = dyn_cast<Instruction>(
       OuterWr->getOperand(GenXIntrinsic::GenXRegion::NewValueOperandNum));
@@ -1045,6 +1099,19 @@ Instruction *GenXRegionCollapsing::processWrRegionSplat(Instruction *OuterWr)
   return CombinedWr;
 }
 
+/***********************************************************************
+ * isSettled : check whether a wrregion has already been found to have
+ *      nothing to collapse for the given kind of processing in this sweep
+ */
+bool GenXRegionCollapsing::isSettled(Instruction *Wr, SettledKind Kind) const
+{
+  auto It = SettledWrRegions.find(Wr);
+  if (It == SettledWrRegions.end() || !(It->second & Kind))
+    return false;
+  ++NumSettledWrRegionHits;
+  return true;
+}
+
 /***********************************************************************
  * normalizeElementType : where two regions have different element size,
  *      make them the same if possible
@@ -52,6 +52,7 @@ private:
 namespace llvm { void initializeGenXRematerializationPass(PassRegistry &); }
 char GenXRematerialization::ID = 0;
 INITIALIZE_PASS_BEGIN(GenXRematerialization, "GenXRematerialization", "GenXRematerialization", false, false)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeGroupWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(GenXGroupBaling)
 INITIALIZE_PASS_DEPENDENCY(GenXLiveness)
 INITIALIZE_PASS_DEPENDENCY(GenXNumbering)
@@ -64,9 +65,14 @@ FunctionGroupPass *llvm::createGenXRematerializationPass() {
 
 void GenXRematerialization::getAnalysisUsage(AnalysisUsage &AU) const {
   FunctionGroupPass::getAnalysisUsage(AU);
+  // Baling needs the dominator trees to rebale the clones.
+  AU.addRequired<DominatorTreeGroupWrapperPass>();
   AU.addRequired<GenXGroupBaling>();
   AU.addRequired<GenXLiveness>();
   AU.addRequired<GenXNumbering>();
+  // Baling is updated for the clones. Liveness and numbering are not, and
+  // are recomputed.
+  AU.addPreserved<GenXGroupBaling>();
   AU.addPreserved<GenXModule>();
   AU.addPreserved<FunctionGroupAnalysis>();
   AU.setPreservesCFG();
@@ -88,6 +94,7 @@ bool GenXRematerialization::runOnFunctionGroup(FunctionGroup &FG) {
 }
 
 void GenXRematerialization::remat(Function *F, PressureTracker &RP) {
+  auto *DT = getAnalysis<DominatorTreeGroupWrapperPass>().getDomTree(F);
   // Collect rematerialization candidates.
   std::vector<Use *> Candidates;
   for (auto &BB : F->getBasicBlockList()) {
@@ -126,6 +133,7 @@ void GenXRematerialization::remat(Function *F, PressureTracker &RP) {
     Instruction *Clone = Inst->clone();
     Clone->insertBefore(UI);
     U->set(Clone);
+    Baling->rebaleInst(Clone, DT);
     Modified = true;
   }
 }
@@ -21,6 +21,7 @@ SPDX-License-Identifier: MIT
 
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/GenXIntrinsics/GenXIntrinsics.h"
@@ -42,9 +43,14 @@ SPDX-License-Identifier: MIT
 #include <cstddef>
 #include <iterator>
 
+#define DEBUG_TYPE "GENX_UTIL"
+
 using namespace llvm;
 using namespace genx;
 
+STATISTIC(NumSplitsForwarded,
+          "Number of i64 splits forwarded from a preceding join");
+
 namespace {
 struct InstScanner {
   Instruction *Original;
@@ -1156,6 +1162,59 @@ static void convertI64ToI32(Constant &K, SmallVectorImpl<Constant *> &K32) {
   }
 }
 
+// Region parsing canonicalizes the stride of a single-element region, so
+// the stride is only compared for more than one element. Width and vstride
+// are compared so that a 2D region with the same element count and offset
+// is not taken for the 1D split region.
+Value *IVSplitter::getSplitWrRegionInput(Value *V, RegionType RT) const {
+  if (!GenXIntrinsic::isWrRegion(V))
+    return nullptr;
+  auto *WrR = cast<Instruction>(V);
+  if (WrR->getType() != VI32Ty)
+    return nullptr;
+  Region Expected = createSplitRegion(VI32Ty, RT);
+  Region Actual(WrR, BaleInfo());
+  if (Actual.Indirect || Actual.Mask ||
+      Actual.NumElements != Expected.NumElements ||
+      Actual.Width != Expected.Width || Actual.VStride != Expected.VStride ||
+      Actual.Offset != Expected.Offset ||
+      (Actual.NumElements > 1 && Actual.Stride != Expected.Stride))
+    return nullptr;
+  return WrR->getOperand(GenXIntrinsic::GenXRegion::NewValueOperandNum);
+}
+
+// If Val has been produced by combineSplit with the same pair of region
+// types, return the original parts instead of emitting a bitcast plus two
+// rdregions. This keeps lo/hi (or half) parts flowing between consecutive
+// emulated 64-bit operations; the dead join is cleaned up by later DCE.
+std::pair<Value *, Value *>
+IVSplitter::forwardCombinedSplit(Value &Val, RegionType RT1,
+                                 RegionType RT2) const {
+  Value *V = &Val;
+  // Skip the scalarizing recast.
+  if (auto *BC = dyn_cast<BitCastInst>(V))
+    if (!BC->getType()->isVectorTy())
+      V = BC->getOperand(0);
+  auto *Join = dyn_cast<BitCastInst>(V);
+  if (!Join || Join->getSrcTy() != VI32Ty)
+    return {nullptr, nullptr};
+  Value *W2 = Join->getOperand(0);
+  Value *V2 = getSplitWrRegionInput(W2, RT2);
+  if (!V2)
+    return {nullptr, nullptr};
+  Value *W1 = cast<Instruction>(W2)->getOperand(
+      GenXIntrinsic::GenXRegion::OldValueOperandNum);
+  Value *V1 = getSplitWrRegionInput(W1, RT1);
+  if (!V1 || !isa<UndefValue>(cast<Instruction>(W1)->getOperand(
+                 GenXIntrinsic::GenXRegion::OldValueOperandNum)))
+    return {nullptr, nullptr};
+  // splitValue always yields vector parts, so must the forwarded ones.
+  auto *PartTy = IGCLLVM::FixedVectorType::get(VI32Ty->getScalarType(), Len);
+  if (V1->getType() != PartTy || V2->getType() != PartTy)
+    return {nullptr, nullptr};
+  return {V1, V2};
+}
+
 std::pair<Value *, Value *>
 IVSplitter::splitValue(Value &Val, RegionType RT1, const Twine &Name1,
                        RegionType RT2, const Twine &Name2, bool FoldConstants) {
@@ -1171,6 +1230,11 @@ IVSplitter::splitValue(Value &Val, RegionType RT1, const Twine &Name1,
     Value *V2 = splitConstantVector(KV32, RT2);
     return {V1, V2};
   }
+  auto Forwarded = forwardCombinedSplit(Val, RT1, RT2);
+  if (Forwarded.first) {
+    ++NumSplitsForwarded;
+    return Forwarded;
+  }
   auto *ShreddedVal = new BitCastInst(&Val, VI32Ty, BaseName + ".iv32cast", &Inst);
   ShreddedVal->setDebugLoc(DL);
 
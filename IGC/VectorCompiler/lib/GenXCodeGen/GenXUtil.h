@@ -347,6 +347,14 @@ class IVSplitter {
   // rdregion intrinsic
   static genx::Region createSplitRegion(Type *SrcTy, RegionType RT);
 
+  // getSplitWrRegionInput: if V is a wrregion writing exactly the region
+  // createSplitRegion(VI32Ty, RT) describes, returns the written value
+  Value *getSplitWrRegionInput(Value *V, RegionType RT) const;
+  // forwardCombinedSplit: if Val was built by combineSplit with RT1/RT2,
+  // returns the original parts (or a pair of nullptr otherwise)
+  std::pair<Value *, Value *> forwardCombinedSplit(Value &Val, RegionType RT1,
+                                                   RegionType RT2) const;
+
   std::pair<Value *, Value *> splitValue(Value &Val, RegionType RT1,
                                          const Twine &Name1, RegionType RT2,
                                          const Twine &Name2,
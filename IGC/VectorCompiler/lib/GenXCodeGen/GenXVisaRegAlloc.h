@@ -49,6 +49,8 @@ SPDX-License-Identifier: MIT
 #include "Probe/Assertion.h"
 #include "visaBuilder_interface.h"
 
+#include "llvm/ADT/DenseMap.h"
+
 #include <map>
 #include <string>
 #include <vector>
@@ -127,7 +129,7 @@ namespace llvm {
     };
 
     using RegPushHook = void(*)(void* Object, Reg&);
-    using KernRegMap_t = std::map<genx::SimpleValue, Reg*>;
+    using KernRegMap_t = DenseMap<genx::SimpleValue, Reg*>;
     using RegMap_t = std::map<const Function*, KernRegMap_t>;
   private:
     FunctionGroup *FG = nullptr;
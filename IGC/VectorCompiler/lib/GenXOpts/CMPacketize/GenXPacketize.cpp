@@ -29,6 +29,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/GenXIntrinsics/GenXIntrinsics.h"
 #include "llvm/GenXIntrinsics/GenXSimdCFLowering.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
 #include "llvm/Transforms/Scalar.h"
@@ -68,6 +69,9 @@ namespace llvm {
 /// e) for uniform arguments
 ///    Mark the allocas for those arguments as uniform
 ///    Mark the load/store for those allocas as uniform
+///    Mark arithmetic, compares, casts and selects on uniform values as
+///    uniform, so branches on them stay scalar and only divergent branches
+///    become SIMD control-flow
 ///
 /// f) vectorize generic functions to its SIMT width, callee first
 ///    - create the vector prototype
@@ -124,8 +128,10 @@ private:
   bool vectorizeSIMTEntry(Function &F);
 
   bool isUniformIntrinsic(unsigned id);
+  bool isUniformValue(const Value *V) const;
   void findUniformArgs(Function &F);
   void findUniformInsts(Function &F);
+  void propagateUniformInsts(Function &F);
 
   void lowerControlFlowAfter(std::vector<Function *> &SIMTFuncs);
   GlobalVariable *findGlobalExecMask();
@@ -139,7 +145,7 @@ private:
 
   /// uniform set for arguments
   std::set<const Argument *> UniformArgs;
-  /// uniform set for alloca, load, store, and GEP
+  /// uniform set for alloca, load, store, GEP and arithmetic on those
   std::set<const Instruction *> UniformInsts;
   /// sort function in caller-first order
   std::vector<Function *> FuncOrder;
@@ -694,7 +700,55 @@ void GenXPacketize::findUniformInsts(Function &F) {
       }
     }
   }
-  return;
+  propagateUniformInsts(F);
+}
+
+bool GenXPacketize::isUniformValue(const Value *V) const {
+  if (isa<Constant>(V))
+    return true;
+  if (auto A = dyn_cast<Argument>(V))
+    return UniformArgs.count(A);
+  if (auto I = dyn_cast<Instruction>(V))
+    return UniformInsts.count(I);
+  return false;
+}
+
+/***************************************************************************
+ * propagateUniformInsts : mark side-effect free scalar computations whose
+ * operands are all uniform as uniform, iterating until nothing changes.
+ *
+ * This keeps e.g. a compare of a uniform argument against a constant scalar,
+ * so a branch on it stays an ordinary branch instead of going through
+ * simdcf.any and SIMD control-flow lowering. Values feeding phi nodes are
+ * left alone because a broadcast for them cannot be placed at the phi, so
+ * anything computed from a loop induction variable, such as the compare of
+ * a loop bound, is not uniform here.
+ */
+void GenXPacketize::propagateUniformInsts(Function &F) {
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    for (auto &I : instructions(F)) {
+      if (UniformInsts.count(&I))
+        continue;
+      if (!isa<BinaryOperator>(I) && !isa<CmpInst>(I) && !isa<CastInst>(I) &&
+          !isa<SelectInst>(I))
+        continue;
+      if (!I.getType()->isIntOrIntVectorTy() &&
+          !I.getType()->isFPOrFPVectorTy())
+        continue;
+      if (I.getType()->isVectorTy())
+        continue;
+      if (std::any_of(I.user_begin(), I.user_end(),
+                      [](const User *U) { return isa<PHINode>(U); }))
+        continue;
+      if (!std::all_of(I.op_begin(), I.op_end(),
+                       [this](const Use &U) { return isUniformValue(U); }))
+        continue;
+      UniformInsts.insert(&I);
+      Changed = true;
+    }
+  }
 }
 
 Value *GenXPacketize::getPacketizeValue(Value *OrigValue) {
@@ -1064,9 +1118,10 @@ Value *GenXPacketize::packetizeLLVMInstruction(Instruction *pInst) {
 
   case Instruction::Br: {
     // any conditional branches with vectored conditions need to preceded with
-    // a genx_simdcf_any to ensure we branch iff all lanes are set
+    // a genx_simdcf_any to ensure we branch iff all lanes are set. Branches
+    // on uniform conditions go the same way for all lanes and stay scalar.
     BranchInst *pBranch = cast<BranchInst>(pInst);
-    if (pBranch->isConditional()) {
+    if (pBranch->isConditional() && !isUniformValue(pBranch->getCondition())) {
       Value *vCondition = getPacketizeValue(pBranch->getCondition());
       llvm::Function *NewFn = GenXIntrinsic::getGenXDeclaration(
         B->mpModule,
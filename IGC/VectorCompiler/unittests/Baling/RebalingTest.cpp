@@ -0,0 +1,211 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "llvm/ADT/Triple.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "vc/GenXCodeGen/GenXTarget.h"
+
+#include "FunctionGroup.h"
+#include "GenX.h"
+#include "GenXBaling.h"
+#include "GenXRegion.h"
+#include "GenXTargetMachine.h"
+
+#include "llvmWrapper/IR/DerivedTypes.h"
+
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <memory>
+
+using namespace llvm;
+using namespace genx;
+
+namespace {
+
+unsigned countInsts(Function &F) {
+  unsigned Count = 0;
+  for (BasicBlock &BB : F)
+    Count += BB.size();
+  return Count;
+}
+
+// A baled in instruction must have exactly one use.
+bool baledOperandsHaveOneUse(Function &F, const GenXBaling &Baling) {
+  for (Instruction &I : instructions(F)) {
+    BaleInfo BI = Baling.getBaleInfo(&I);
+    for (unsigned i = 0, e = I.getNumOperands(); i != e; ++i)
+      if (BI.isOperandBaled(i) && !I.getOperand(i)->hasOneUse())
+        return false;
+  }
+  return true;
+}
+
+// Runs Check on the group baling that the passes before it left behind.
+class BalingChecker : public FunctionGroupPass {
+  std::function<void(FunctionGroup &, GenXBaling &)> Check;
+
+public:
+  static char ID;
+  explicit BalingChecker(
+      std::function<void(FunctionGroup &, GenXBaling &)> Check)
+      : FunctionGroupPass(ID), Check(std::move(Check)) {}
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    FunctionGroupPass::getAnalysisUsage(AU);
+    AU.addRequired<GenXGroupBaling>();
+    AU.setPreservesAll();
+  }
+  bool runOnFunctionGroup(FunctionGroup &FG) override {
+    Check(FG, getAnalysis<GenXGroupBaling>());
+    return false;
+  }
+};
+char BalingChecker::ID = 0;
+
+// f(<16 x i16> %in, <960 x i32> %big, <8 x float>* %p): a sitofp of an
+// rdregion of %in is used three times, on both sides of a use of %big that
+// keeps the register pressure high enough for rematerialization.
+Function *buildRematCandidate(Module &M) {
+  LLVMContext &Context = M.getContext();
+  auto *InTy = IGCLLVM::FixedVectorType::get(Type::getInt16Ty(Context), 16);
+  auto *BigTy = IGCLLVM::FixedVectorType::get(Type::getInt32Ty(Context), 960);
+  auto *FTy = IGCLLVM::FixedVectorType::get(Type::getFloatTy(Context), 8);
+  auto *FnTy = FunctionType::get(Type::getVoidTy(Context),
+                                 {InTy, BigTy, FTy->getPointerTo()}, false);
+  Function *F =
+      Function::Create(FnTy, GlobalValue::ExternalLinkage, "remat", M);
+  auto *BB = BasicBlock::Create(Context, "entry", F);
+  IRBuilder<> Builder(BB);
+  Instruction *Ret = Builder.CreateRetVoid();
+  Builder.SetInsertPoint(Ret);
+
+  auto ArgIt = F->arg_begin();
+  Value *In = &*ArgIt++;
+  Value *Big = &*ArgIt++;
+  Value *Ptr = &*ArgIt;
+  genx::Region R(InTy);
+  R.NumElements = R.Width = 8;
+  R.VStride = 0;
+  R.Stride = 2;
+  R.Offset = 0;
+  Instruction *Rd = R.createRdRegion(In, "rd", Ret, DebugLoc());
+  Value *Cast = Builder.CreateSIToFP(Rd, FTy, "cast");
+  Builder.CreateStore(Builder.CreateFAdd(Cast, Cast), Ptr);
+  Value *BigSum = Builder.CreateAdd(Big, Big);
+  Builder.CreateStore(BigSum,
+                      Builder.CreateBitCast(Ptr, BigTy->getPointerTo()));
+  Builder.CreateStore(Cast, Ptr);
+  return F;
+}
+
+// Rematerialization clones the sitofp next to its far use and keeps the
+// baling analysis. The baling that the next pass sees must be valid: each
+// clone has its own copy of the baled in rdregion, and the original sitofp
+// keeps its bale.
+TEST(GenXCodeGen, RematerializationRebalesClones) {
+  initializeGenX();
+  LLVMInitializeGenXPasses();
+  LLVMContext Context;
+  Module M("RematerializationRebalesClones", Context);
+  Triple TT("genx64-unknown-unknown");
+  M.setTargetTriple(TT.getTriple());
+  std::string Err;
+  const Target *T =
+      TargetRegistry::lookupTarget(TT.getArchName().str(), TT, Err);
+  ASSERT_TRUE(T) << Err;
+  std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+      TT.getTriple(), "Gen9", "", TargetOptions(), None));
+  ASSERT_TRUE(TM);
+  M.setDataLayout(TM->createDataLayout());
+  auto &GTM = static_cast<GenXTargetMachine &>(*TM);
+  Function *F = buildRematCandidate(M);
+
+  unsigned NumCasts = 0;
+  bool Valid = false;
+  bool OriginalKeepsBale = false;
+  legacy::PassManager PM;
+  PM.add(GTM.createPassConfig(PM));
+  PM.add(createGenXModulePass());
+  PM.add(createGenXGroupBalingPass(
+      BalingKind::BK_Analysis,
+      const_cast<GenXSubtarget *>(&GTM.getGenXSubtarget())));
+  PM.add(createGenXLivenessPass());
+  PM.add(createGenXNumberingPass());
+  PM.add(createGenXLiveRangesPass());
+  PM.add(createGenXRematerializationPass());
+  PM.add(new BalingChecker([&](FunctionGroup &, GenXBaling &Baling) {
+    for (Instruction &I : instructions(*F)) {
+      if (!isa<SIToFPInst>(I))
+        continue;
+      ++NumCasts;
+      if (I.getName() == "cast")
+        OriginalKeepsBale = Baling.getBaleInfo(&I).isOperandBaled(0);
+    }
+    Valid = baledOperandsHaveOneUse(*F, Baling);
+  }));
+  PM.run(M);
+
+  EXPECT_GT(NumCasts, 1u);
+  EXPECT_TRUE(Valid);
+  EXPECT_TRUE(OriginalKeepsBale);
+}
+
+// Cloning a user of a baled in rdregion, as rematerialization does, gives the
+// rdregion a second use. Rebaling the clone must give it its own copy of the
+// rdregion and leave the bale of the original user alone.
+TEST(GenXCodeGen, RebaleInstClonesSharedOperand) {
+  LLVMContext Context;
+  Module M("RebaleInstClonesSharedOperand", Context);
+  auto *I32Ty = Type::getInt32Ty(Context);
+  auto *InTy = IGCLLVM::FixedVectorType::get(I32Ty, 16);
+  auto *FTy = FunctionType::get(Type::getVoidTy(Context), {InTy}, false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", M);
+  auto *BB = BasicBlock::Create(Context, "entry", F);
+  IRBuilder<> Builder(BB);
+  Instruction *Ret = Builder.CreateRetVoid();
+
+  genx::Region R(InTy);
+  R.NumElements = R.Width = 8;
+  R.VStride = 0;
+  R.Stride = 1;
+  R.Offset = 0;
+  Instruction *Rd = R.createRdRegion(&*F->arg_begin(), "rd", Ret, DebugLoc());
+  auto *Add = BinaryOperator::CreateAdd(
+      Rd, ConstantInt::get(Rd->getType(), 1), "add", Ret);
+
+  GenXGroupBaling Baling(BalingKind::BK_Analysis, nullptr);
+  DominatorTree DT(*F);
+  Baling.processFunction(F);
+  ASSERT_TRUE(Baling.getBaleInfo(Add).isOperandBaled(0));
+
+  Instruction *Clone = Add->clone();
+  Clone->insertBefore(Ret);
+  const unsigned NumInsts = countInsts(*F);
+  Baling.rebaleInst(Clone, &DT);
+
+  EXPECT_EQ(countInsts(*F), NumInsts + 1);
+  EXPECT_TRUE(Rd->hasOneUse());
+  EXPECT_EQ(Add->getOperand(0), Rd);
+  EXPECT_TRUE(Baling.getBaleInfo(Add).isOperandBaled(0));
+  EXPECT_NE(Clone->getOperand(0), Rd);
+  EXPECT_TRUE(GenXIntrinsic::isRdRegion(Clone->getOperand(0)));
+  EXPECT_TRUE(Baling.getBaleInfo(Clone).isOperandBaled(0));
+  EXPECT_TRUE(baledOperandsHaveOneUse(*F, Baling));
+}
+
+} // namespace
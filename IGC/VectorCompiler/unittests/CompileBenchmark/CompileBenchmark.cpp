@@ -0,0 +1,354 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// VCCompileBenchmark: compile every SPIR-V/LLVM module in a directory with
+// vc::Compile several times and report per-pass wall time (from the legacy
+// pass manager timers), total wall time, peak RSS and output size as CSV or
+// JSON. No GPU is needed, only the backend.
+//
+// Example:
+//   VCCompileBenchmark kernels/ -bench-runs=10 \
+//     -bench-api-options="-vc-codegen" \
+//     -bench-internal-options="-binary-format=ocl" -bench-cpu=Gen9 \
+//     -bench-format=json
+
+#include "vc/BiF/Wrapper.h"
+#include "vc/Driver/Driver.h"
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace llvm;
+
+// The backend registers its own global options in the same process and
+// vc::Compile feeds api options through the same parser, so every option of
+// the benchmark is prefixed and kept in its own category.
+static cl::OptionCategory BenchCategory("VC compile benchmark options");
+
+static cl::opt<std::string> InputDir(cl::Positional, cl::Required,
+                                     cl::desc("<directory with kernels>"),
+                                     cl::cat(BenchCategory));
+
+static cl::opt<unsigned> NumRuns("bench-runs", cl::init(5),
+                                 cl::desc("Number of compilations per input"),
+                                 cl::cat(BenchCategory));
+
+static cl::opt<std::string> ApiOptions("bench-api-options", cl::init(""),
+                                       cl::desc("vc::Compile api options"),
+                                       cl::cat(BenchCategory));
+
+static cl::opt<std::string>
+    InternalOptions("bench-internal-options", cl::init(""),
+                    cl::desc("vc::Compile internal options"),
+                    cl::cat(BenchCategory));
+
+static cl::opt<std::string> CPUStr("bench-cpu", cl::init("Gen9"),
+                                   cl::desc("Target platform"),
+                                   cl::cat(BenchCategory));
+
+static cl::opt<std::string>
+    OCLGenericBiF("bench-ocl-generic-bif", cl::init(""),
+                  cl::desc("OCL generic BiF module; empty if not set"),
+                  cl::cat(BenchCategory));
+
+enum class ReportFormat { CSV, JSON };
+static cl::opt<ReportFormat> Format(
+    "bench-format", cl::init(ReportFormat::CSV), cl::desc("Report format"),
+    cl::values(clEnumValN(ReportFormat::CSV, "csv", "comma separated"),
+               clEnumValN(ReportFormat::JSON, "json", "JSON object")),
+    cl::cat(BenchCategory));
+
+static cl::opt<std::string> OutputFile("bench-output", cl::init("-"),
+                                       cl::desc("Report file"),
+                                       cl::cat(BenchCategory));
+
+namespace {
+// Snapshot of the command line. vc::Compile resets every cl::opt to its
+// default before parsing its own LLVM options, so the globals above cannot
+// be read after the first compilation.
+struct BenchConfig {
+  std::string InputDir;
+  unsigned NumRuns;
+  std::string ApiOptions;
+  std::string InternalOptions;
+  std::string CPUStr;
+  std::string OCLGenericBiF;
+  ReportFormat Format;
+  std::string OutputFile;
+};
+
+struct BenchResult {
+  std::string Input;
+  unsigned Runs = 0;
+  double TotalWallMin = 0;
+  double TotalWallMean = 0;
+  uint64_t PeakRSSKB = 0;
+  uint64_t OutputBytes = 0;
+  // Mean wall time in seconds for each timer, in first-seen order.
+  MapVector<std::string, double> Timers;
+};
+} // namespace
+
+static uint64_t getPeakRSSKB() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS Counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)))
+    return 0;
+  return Counters.PeakWorkingSetSize / 1024;
+#else
+  struct rusage Usage;
+  if (getrusage(RUSAGE_SELF, &Usage))
+    return 0;
+#ifdef __APPLE__
+  return Usage.ru_maxrss / 1024;
+#else
+  return Usage.ru_maxrss;
+#endif
+#endif
+}
+
+static uint64_t getOutputSize(const vc::CompileOutput &Output) {
+  if (auto *CMOut = std::get_if<vc::cm::CompileOutput>(&Output))
+    return CMOut->IsaBinary.size();
+  uint64_t Size = 0;
+  for (auto &Kernel : std::get<vc::ocl::CompileOutput>(Output).Kernels)
+    Size += Kernel.getGenBinary().size() + Kernel.getDebugInfo().size();
+  return Size;
+}
+
+static Optional<vc::FileType> getFileType(StringRef Path) {
+  StringRef Ext = sys::path::extension(Path);
+  if (Ext == ".spv")
+    return vc::FileType::SPIRV;
+  if (Ext == ".bc")
+    return vc::FileType::LLVM_BINARY;
+  if (Ext == ".ll")
+    return vc::FileType::LLVM_TEXT;
+  return None;
+}
+
+static std::unique_ptr<MemoryBuffer> getBiFBuffer(StringRef Data) {
+  return MemoryBuffer::getMemBuffer(Data, "",
+                                    false /* RequiresNullTerminator */);
+}
+
+static Expected<vc::ExternalData> loadExternalData(const BenchConfig &Cfg) {
+  vc::ExternalData ExtData;
+  if (Cfg.OCLGenericBiF.empty()) {
+    ExtData.OCLGenericBIFModule = getBiFBuffer("");
+  } else {
+    auto BufOrErr = MemoryBuffer::getFile(Cfg.OCLGenericBiF);
+    if (!BufOrErr)
+      return errorCodeToError(BufOrErr.getError());
+    ExtData.OCLGenericBIFModule = std::move(BufOrErr.get());
+  }
+  // Printf flavour does not affect compile time, take the OCL one.
+  ExtData.VCPrintf32BIFModule =
+      getBiFBuffer(vc::bif::getRawData<vc::bif::RawKind::PrintfOCL32>());
+  ExtData.VCPrintf64BIFModule =
+      getBiFBuffer(vc::bif::getRawData<vc::bif::RawKind::PrintfOCL64>());
+  ExtData.VCEmulationBIFModule =
+      getBiFBuffer(vc::bif::getRawData<vc::bif::RawKind::Emulation>());
+  ExtData.VCSPIRVBuiltinsBIFModule =
+      getBiFBuffer(vc::bif::getRawData<vc::bif::RawKind::SPIRVBuiltins>());
+  return std::move(ExtData);
+}
+
+// Add wall times from a JSON timer report written by vc::Compile to Timers.
+// Keys look like "time.<group>.<timer>.wall".
+static Error accumulateTimers(StringRef ReportPath,
+                              MapVector<std::string, double> &Timers) {
+  auto BufOrErr = MemoryBuffer::getFile(ReportPath);
+  if (!BufOrErr)
+    return errorCodeToError(BufOrErr.getError());
+  Expected<json::Value> Report = json::parse(BufOrErr.get()->getBuffer());
+  if (!Report)
+    return Report.takeError();
+  const json::Object *Obj = Report->getAsObject();
+  if (!Obj)
+    return createStringError(inconvertibleErrorCode(),
+                             "timer report is not a JSON object");
+  for (const auto &Entry : *Obj) {
+    StringRef Key = Entry.first;
+    if (!Key.consume_front("time.") || !Key.consume_back(".wall"))
+      continue;
+    if (Optional<double> Seconds = Entry.second.getAsNumber())
+      Timers[Key.str()] += *Seconds;
+  }
+  return Error::success();
+}
+
+static Expected<BenchResult> runBenchmark(const BenchConfig &Cfg,
+                                          StringRef Path, vc::FileType FType,
+                                          const vc::ExternalData &ExtData,
+                                          StringRef ReportPath) {
+  auto BufOrErr = MemoryBuffer::getFile(Path, /*FileSize=*/-1,
+                                        /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return errorCodeToError(BufOrErr.getError());
+  ArrayRef<char> Input{BufOrErr.get()->getBufferStart(),
+                       BufOrErr.get()->getBufferSize()};
+
+  auto ExpOpts = vc::ParseOptions(Cfg.ApiOptions, Cfg.InternalOptions,
+                                  /*IsStrictMode=*/false);
+  if (!ExpOpts)
+    return ExpOpts.takeError();
+  vc::CompileOptions &Opts = ExpOpts.get();
+  Opts.FType = FType;
+  Opts.CPUStr = Cfg.CPUStr;
+  Opts.TimePasses = true;
+  Opts.TimePassesFile = ReportPath.str();
+
+  BenchResult Result;
+  Result.Input = sys::path::filename(Path).str();
+  Result.TotalWallMin = std::numeric_limits<double>::max();
+  for (unsigned Run = 0; Run != Cfg.NumRuns; ++Run) {
+    auto Start = std::chrono::steady_clock::now();
+    auto ExpOutput = vc::Compile(Input, Opts, ExtData, {}, {});
+    std::chrono::duration<double> Wall =
+        std::chrono::steady_clock::now() - Start;
+    if (!ExpOutput)
+      return ExpOutput.takeError();
+    if (Error Err = accumulateTimers(ReportPath, Result.Timers))
+      return std::move(Err);
+    Result.OutputBytes = getOutputSize(ExpOutput.get());
+    Result.TotalWallMin = std::min(Result.TotalWallMin, Wall.count());
+    Result.TotalWallMean += Wall.count();
+    ++Result.Runs;
+  }
+  Result.TotalWallMean /= Result.Runs;
+  for (auto &Timer : Result.Timers)
+    Timer.second /= Result.Runs;
+  // Process-wide high-water mark, so it never drops between inputs.
+  Result.PeakRSSKB = getPeakRSSKB();
+  return std::move(Result);
+}
+
+static void printCSV(ArrayRef<BenchResult> Results, raw_ostream &OS) {
+  OS << "input,metric,value\n";
+  for (const BenchResult &R : Results) {
+    OS << R.Input << ",runs," << R.Runs << "\n";
+    OS << R.Input << ",total.wall.min," << R.TotalWallMin << "\n";
+    OS << R.Input << ",total.wall.mean," << R.TotalWallMean << "\n";
+    OS << R.Input << ",peak_rss_kb," << R.PeakRSSKB << "\n";
+    OS << R.Input << ",output_bytes," << R.OutputBytes << "\n";
+    for (const auto &Timer : R.Timers)
+      OS << R.Input << "," << Timer.first << ".wall.mean," << Timer.second
+         << "\n";
+  }
+}
+
+static void printJSON(ArrayRef<BenchResult> Results, raw_ostream &OS) {
+  json::OStream J(OS, 2);
+  J.array([&] {
+    for (const BenchResult &R : Results) {
+      J.object([&] {
+        J.attribute("input", R.Input);
+        J.attribute("runs", static_cast<int64_t>(R.Runs));
+        J.attribute("total_wall_min", R.TotalWallMin);
+        J.attribute("total_wall_mean", R.TotalWallMean);
+        J.attribute("peak_rss_kb", static_cast<int64_t>(R.PeakRSSKB));
+        J.attribute("output_bytes", static_cast<int64_t>(R.OutputBytes));
+        J.attributeObject("timers_wall_mean", [&] {
+          for (const auto &Timer : R.Timers)
+            J.attribute(Timer.first, Timer.second);
+        });
+      });
+    }
+  });
+  OS << "\n";
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::HideUnrelatedOptions(BenchCategory);
+  cl::ParseCommandLineOptions(argc, argv, "VC compile-time benchmark\n");
+  const BenchConfig Cfg{InputDir,   NumRuns,       ApiOptions, InternalOptions,
+                        CPUStr,     OCLGenericBiF, Format,     OutputFile};
+  if (!Cfg.NumRuns) {
+    WithColor::error() << "-bench-runs must be positive\n";
+    return 1;
+  }
+
+  auto ExpExtData = loadExternalData(Cfg);
+  if (!ExpExtData) {
+    logAllUnhandledErrors(ExpExtData.takeError(), WithColor::error());
+    return 1;
+  }
+
+  SmallString<128> ReportPath;
+  if (std::error_code EC =
+          sys::fs::createTemporaryFile("vc-bench-timers", "json", ReportPath)) {
+    WithColor::error() << "cannot create timer report: " << EC.message()
+                       << "\n";
+    return 1;
+  }
+  FileRemover ReportRemover(ReportPath);
+
+  std::vector<std::string> Inputs;
+  std::error_code EC;
+  for (sys::fs::directory_iterator It(Cfg.InputDir, EC), End; It != End && !EC;
+       It.increment(EC))
+    if (getFileType(It->path()))
+      Inputs.push_back(It->path());
+  if (EC) {
+    WithColor::error() << Cfg.InputDir << ": " << EC.message() << "\n";
+    return 1;
+  }
+  // Directory order is unspecified; keep reports comparable between runs.
+  std::sort(Inputs.begin(), Inputs.end());
+
+  std::vector<BenchResult> Results;
+  bool Failed = false;
+  for (const std::string &Path : Inputs) {
+    auto ExpResult =
+        runBenchmark(Cfg, Path, *getFileType(Path), *ExpExtData, ReportPath);
+    if (!ExpResult) {
+      logAllUnhandledErrors(ExpResult.takeError(), WithColor::error(),
+                            Path + ": ");
+      Failed = true;
+      continue;
+    }
+    Results.push_back(std::move(ExpResult.get()));
+  }
+
+  raw_fd_ostream OS(Cfg.OutputFile, EC, sys::fs::OF_Text);
+  if (EC) {
+    WithColor::error() << Cfg.OutputFile << ": " << EC.message() << "\n";
+    return 1;
+  }
+  if (Cfg.Format == ReportFormat::CSV)
+    printCSV(Results, OS);
+  else
+    printJSON(Results, OS);
+  return Failed ? 1 : 0;
+}
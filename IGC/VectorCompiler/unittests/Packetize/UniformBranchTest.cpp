@@ -0,0 +1,78 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/GenXIntrinsics/GenXIntrinsics.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include "vc/GenXOpts/GenXOpts.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace llvm;
+
+namespace {
+
+std::unique_ptr<Module> packetize(LLVMContext &Context, StringRef IR) {
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Context);
+  if (!M)
+    return nullptr;
+  legacy::PassManager PM;
+  PM.add(createGenXPacketizePass());
+  PM.run(*M);
+  return M;
+}
+
+bool hasSIMDCF(const Module &M) {
+  for (const Function &F : M) {
+    switch (GenXIntrinsic::getGenXIntrinsicID(&F)) {
+    case GenXIntrinsic::genx_simdcf_any:
+    case GenXIntrinsic::genx_simdcf_goto:
+    case GenXIntrinsic::genx_simdcf_join:
+      if (!F.use_empty())
+        return true;
+      break;
+    default:
+      break;
+    }
+  }
+  return false;
+}
+
+// A compare of a uniform argument is uniform, so the branch on it stays a
+// scalar branch and no SIMD control flow is generated.
+TEST(GenXOpts, PacketizeKeepsUniformBranchScalar) {
+  LLVMContext Context;
+  auto M = packetize(Context, R"(
+define void @f(i32 %n) #0 {
+entry:
+  %c = icmp sgt i32 %n, 0
+  br i1 %c, label %then, label %exit
+then:
+  br label %exit
+exit:
+  ret void
+}
+attributes #0 = { "CMGenxSIMT"="8" }
+)");
+  ASSERT_TRUE(M);
+  EXPECT_FALSE(hasSIMDCF(*M));
+  auto *Br = cast<BranchInst>(
+      M->getFunction("f")->getEntryBlock().getTerminator());
+  ASSERT_TRUE(Br->isConditional());
+  EXPECT_TRUE(Br->getCondition()->getType()->isIntegerTy(1));
+}
+
+} // namespace
@@ -0,0 +1,100 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "GenXRegion.h"
+#include "GenXUtil.h"
+
+#include "llvmWrapper/IR/DerivedTypes.h"
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+constexpr unsigned NumI64 = 8;
+
+// Function taking the lo and hi i32 parts of a <NumI64 x i64> value, with an
+// i64 instruction to split at.
+struct SplitFixture {
+  Function *F;
+  Value *Lo;
+  Value *Hi;
+  Instruction *I64Inst;
+
+  explicit SplitFixture(Module &M) {
+    LLVMContext &Context = M.getContext();
+    auto *PartTy =
+        IGCLLVM::FixedVectorType::get(Type::getInt32Ty(Context), NumI64);
+    auto *I64Ty =
+        IGCLLVM::FixedVectorType::get(Type::getInt64Ty(Context), NumI64);
+    auto *FTy = FunctionType::get(Type::getVoidTy(Context), {PartTy, PartTy},
+                                  false);
+    F = Function::Create(FTy, GlobalValue::ExternalLinkage, "split", M);
+    auto *BB = BasicBlock::Create(Context, "entry", F);
+    IRBuilder<> Builder(BB);
+    Instruction *Ret = Builder.CreateRetVoid();
+    auto ArgIt = F->arg_begin();
+    Lo = &*ArgIt++;
+    Hi = &*ArgIt;
+    I64Inst = BinaryOperator::CreateAdd(UndefValue::get(I64Ty),
+                                        UndefValue::get(I64Ty), "i64", Ret);
+  }
+};
+
+// Splitting the result of combineLoHiSplit gives back the original parts.
+TEST(GenXCodeGen, IVSplitterForwardsCombinedSplit) {
+  LLVMContext Context;
+  Module M("IVSplitterForwardsCombinedSplit", Context);
+  SplitFixture Fix(M);
+
+  genx::IVSplitter Splitter(*Fix.I64Inst);
+  Value *Joined = Splitter.combineLoHiSplit({Fix.Lo, Fix.Hi}, "joined",
+                                            /*Scalarize=*/false);
+  auto Split = Splitter.splitValueLoHi(*Joined);
+  EXPECT_EQ(Split.Lo, Fix.Lo);
+  EXPECT_EQ(Split.Hi, Fix.Hi);
+}
+
+// A join through 2D wrregions with the element count, offset and stride of
+// the lo/hi regions writes other elements, so it must not be forwarded.
+TEST(GenXCodeGen, IVSplitterDoesNotForward2DJoin) {
+  LLVMContext Context;
+  Module M("IVSplitterDoesNotForward2DJoin", Context);
+  SplitFixture Fix(M);
+
+  auto *VI32Ty =
+      IGCLLVM::FixedVectorType::get(Type::getInt32Ty(Context), NumI64 * 2);
+  genx::Region R(VI32Ty);
+  R.NumElements = NumI64;
+  R.Width = NumI64 / 2;
+  R.Stride = 2;
+  R.VStride = 1;
+  R.Offset = 0;
+  auto *W1 = R.createWrRegion(UndefValue::get(VI32Ty), Fix.Lo, "lo",
+                              Fix.I64Inst, DebugLoc());
+  R.Offset = 4;
+  auto *W2 = R.createWrRegion(W1, Fix.Hi, "hi", Fix.I64Inst, DebugLoc());
+  auto *Joined = new BitCastInst(W2, Fix.I64Inst->getType(), "joined",
+                                 Fix.I64Inst);
+
+  genx::IVSplitter Splitter(*Fix.I64Inst);
+  auto Split = Splitter.splitValueLoHi(*Joined);
+  EXPECT_NE(Split.Lo, Fix.Lo);
+  EXPECT_NE(Split.Hi, Fix.Hi);
+  EXPECT_TRUE(GenXIntrinsic::isRdRegion(Split.Lo));
+  EXPECT_TRUE(GenXIntrinsic::isRdRegion(Split.Hi));
+}
+
+} // namespace
@@ -8,10 +8,18 @@ SPDX-License-Identifier: MIT
 
 #include "Tester.hpp"
 #include "ZEELFObjectBuilder.hpp"
-#include "ZEinfoYAML.hpp"
+#include "ZEInfoWriter.hpp"
+#include "ZEInfoYAML.hpp"
 
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <random>
+#include <string>
+#include <vector>
 
 using llvm::yaml::Output;
 using llvm::yaml::Input;
@@ -22,7 +30,6 @@ static void getTestZEInfo(zeInfoContainer& ks)
     zeInfoKernel k1;
 
     k1.name = "kernel_name_1";
-    k1.execution_env.actual_kernel_start_offset = 0;
     k1.execution_env.grf_count = 128;
     k1.execution_env.simd_size = 8;
     k1.execution_env.required_work_group_size.push_back(256);
@@ -86,7 +93,6 @@ static void getTestZEInfo(zeInfoContainer& ks)
 
     zeInfoKernel k2;
     k2.name = "kernel_name_2";
-    k2.execution_env.actual_kernel_start_offset = 0;
     k2.execution_env.grf_count = 100;
     k2.execution_env.simd_size = 16;
 
@@ -108,7 +114,214 @@ static void getTestZEInfo(zeInfoContainer& ks)
     ks.kernels.push_back(k2);
 }
 
-void Tester::testZEInfoOutput()
+// set every field of a kernel to a non-default value, with strings that
+// need each of the quoting styles and flow sequences long enough to wrap
+static void getFullZEInfo(zeInfoContainer& ks)
+{
+    ks.version = PreDefinedAttrGetter::getVersionNumber();
+
+    zeInfoKernel k;
+    k.name = "it's a: kernel";
+    zeInfoExecutionEnv& env = k.execution_env;
+    env.barrier_count = 1;
+    env.disable_mid_thread_preemption = true;
+    env.grf_count = 256;
+    env.has_4gb_buffers = true;
+    env.has_device_enqueue = true;
+    env.has_dpas = true;
+    env.has_fence_for_image_access = true;
+    env.has_global_atomics = true;
+    env.has_multi_scratch_spaces = true;
+    env.has_no_stateless_write = true;
+    env.offset_to_skip_per_thread_data_load = 48;
+    env.offset_to_skip_set_ffid_gp = 16;
+    env.required_sub_group_size = 16;
+    for (int i = 0; i < 40; ++i)
+        env.required_work_group_size.push_back(i * 1000);
+    env.simd_size = 32;
+    env.slm_size = 65536;
+    env.subgroup_independent_forward_progress = true;
+    env.work_group_walk_order_dimensions = { 2, 1, 0 };
+
+    zeInfoPayloadArgument arg;
+    arg.arg_type = "arg_bypointer";
+    arg.offset = -8;
+    arg.size = 8;
+    arg.arg_index = 0;
+    arg.addrmode = "true";
+    arg.addrspace = "123";
+    arg.access_type = "tab\there";
+    arg.sampler_index = 3;
+    k.payload_arguments.push_back(arg);
+
+    zeInfoPerThreadPayloadArgument p_arg;
+    p_arg.arg_type = "";
+    p_arg.offset = 0;
+    p_arg.size = 0;
+    k.per_thread_payload_arguments.push_back(p_arg);
+
+    zeInfoBindingTableIndex bti;
+    bti.bti_value = 0;
+    bti.arg_index = 0;
+    k.binding_table_indices.push_back(bti);
+
+    zeInfoPerThreadMemoryBuffer buf;
+    buf.type = "scratch";
+    buf.usage = "private_space";
+    buf.size = 1024;
+    buf.slot = 1;
+    buf.is_simt_thread = true;
+    k.per_thread_memory_buffers.push_back(buf);
+
+    zeInfoExperimentalProperties props;
+    props.has_non_kernel_arg_load = 1;
+    props.has_non_kernel_arg_store = 0;
+    props.has_non_kernel_arg_atomic = 1;
+    k.experimental_properties.push_back(props);
+    // all keys defaulted, written as "- {}"
+    k.experimental_properties.push_back(zeInfoExperimentalProperties());
+
+    zeInfoDebugEnv dbg;
+    dbg.sip_surface_bti = 0;
+    dbg.sip_surface_offset = 64;
+    k.debug_env.push_back(dbg);
+    k.debug_env.push_back(zeInfoDebugEnv());
+
+    ks.kernels.push_back(k);
+}
+
+// fill ks with random contents; every optional field has an even chance of
+// keeping its default value
+static void getRandomZEInfo(std::mt19937& rng, zeInfoContainer& ks)
+{
+    static const char* const strs[] = {
+        "", "local_id", "arg_bypointer", "stateless", "global", "readwrite",
+        "true", "null", "~", "0x10", "-1", "1.5", "a: b", "a #b", "'quoted'",
+        "\"dquoted\"", "tab\tin", "new\nline", " lead", "trail ", "[x]",
+        "{y}", "*star", "&amp", "!bang", "%pct", "@at", "`tick", "it's",
+    };
+    auto rnd = [&](unsigned n) {
+        return (unsigned)(rng() % n);
+    };
+    auto randInt = [&](int32_t dflt) {
+        if (rnd(2))
+            return dflt;
+        switch (rnd(4)) {
+        case 0: return (int32_t)rnd(16);
+        case 1: return -(int32_t)rnd(16);
+        case 2: return (int32_t)rng();
+        default: return dflt + 1;
+        }
+    };
+    auto randBool = [&]() {
+        return rnd(2) != 0;
+    };
+    auto randStr = [&]() {
+        return std::string(strs[rnd(sizeof(strs) / sizeof(strs[0]))]);
+    };
+    auto randInts = [&](std::vector<zeinfo_int32_t>& v) {
+        unsigned n = rnd(3) ? rnd(4) : rnd(64);
+        for (unsigned i = 0; i < n; ++i)
+            v.push_back(randInt(0));
+    };
+
+    ks.version = randStr();
+    unsigned numKernels = rnd(4);
+    for (unsigned i = 0; i < numKernels; ++i) {
+        zeInfoKernel k;
+        k.name = randStr();
+        zeInfoExecutionEnv& env = k.execution_env;
+        env.barrier_count = randInt(0);
+        env.disable_mid_thread_preemption = randBool();
+        env.grf_count = randInt(0);
+        env.has_4gb_buffers = randBool();
+        env.has_device_enqueue = randBool();
+        env.has_dpas = randBool();
+        env.has_fence_for_image_access = randBool();
+        env.has_global_atomics = randBool();
+        env.has_multi_scratch_spaces = randBool();
+        env.has_no_stateless_write = randBool();
+        env.offset_to_skip_per_thread_data_load = randInt(0);
+        env.offset_to_skip_set_ffid_gp = randInt(0);
+        env.required_sub_group_size = randInt(0);
+        randInts(env.required_work_group_size);
+        env.simd_size = randInt(0);
+        env.slm_size = randInt(0);
+        env.subgroup_independent_forward_progress = randBool();
+        randInts(env.work_group_walk_order_dimensions);
+
+        for (unsigned n = rnd(4); n; --n) {
+            zeInfoPayloadArgument arg;
+            arg.arg_type = randStr();
+            arg.offset = randInt(0);
+            arg.size = randInt(0);
+            arg.arg_index = randInt(-1);
+            arg.addrmode = randStr();
+            arg.addrspace = randStr();
+            arg.access_type = randStr();
+            arg.sampler_index = randInt(-1);
+            k.payload_arguments.push_back(arg);
+        }
+        for (unsigned n = rnd(3); n; --n) {
+            zeInfoPerThreadPayloadArgument arg;
+            arg.arg_type = randStr();
+            arg.offset = randInt(0);
+            arg.size = randInt(0);
+            k.per_thread_payload_arguments.push_back(arg);
+        }
+        for (unsigned n = rnd(3); n; --n) {
+            zeInfoBindingTableIndex bti;
+            bti.bti_value = randInt(0);
+            bti.arg_index = randInt(0);
+            k.binding_table_indices.push_back(bti);
+        }
+        for (unsigned n = rnd(3); n; --n) {
+            zeInfoPerThreadMemoryBuffer buf;
+            buf.type = randStr();
+            buf.usage = randStr();
+            buf.size = randInt(0);
+            buf.slot = randInt(0);
+            buf.is_simt_thread = randBool();
+            k.per_thread_memory_buffers.push_back(buf);
+        }
+        for (unsigned n = rnd(3); n; --n) {
+            zeInfoExperimentalProperties props;
+            props.has_non_kernel_arg_load = randInt(-1);
+            props.has_non_kernel_arg_store = randInt(-1);
+            props.has_non_kernel_arg_atomic = randInt(-1);
+            k.experimental_properties.push_back(props);
+        }
+        for (unsigned n = rnd(3); n; --n) {
+            zeInfoDebugEnv dbg;
+            dbg.sip_surface_bti = randInt(-1);
+            dbg.sip_surface_offset = randInt(-1);
+            k.debug_env.push_back(dbg);
+        }
+        ks.kernels.push_back(k);
+    }
+}
+
+// return true if ZEInfoWriter writes the same text as llvm::yaml::Output with
+// the mappings in ZEInfoYAML.cpp, print both otherwise
+static bool matchYAMLOutput(zeInfoContainer& ks)
+{
+    std::string yaml_string;
+    llvm::raw_string_ostream OS(yaml_string);
+    Output yout(OS);
+    yout << ks;
+    OS.flush();
+
+    std::string direct_string;
+    ZEInfoWriter::write(ks, direct_string);
+    if (yaml_string == direct_string)
+        return true;
+
+    std::cout << "ZEInfoWriter output mismatch, llvm::yaml::Output:\n"
+        << yaml_string << "ZEInfoWriter:\n" << direct_string;
+    return false;
+}
+
+bool Tester::testZEInfoOutput()
 {
     zeInfoContainer in_ks;
     getTestZEInfo(in_ks);
@@ -116,6 +329,7 @@ void Tester::testZEInfoOutput()
     llvm::raw_string_ostream OS(in_string);
     Output yout(OS);
     yout << in_ks;
+    std::cout << OS.str();
 
     zeInfoContainer out_ks;
     Input Yin(OS.str());
@@ -125,26 +339,47 @@ void Tester::testZEInfoOutput()
     llvm::raw_string_ostream out_OS(out_string);
     Output out_yout(out_OS);
     out_yout << out_ks;
+
+    // the direct writer used by ZEELFObjectBuilder must produce the same text
+    bool match = matchYAMLOutput(in_ks);
+
+    zeInfoContainer empty_ks;
+    match &= matchYAMLOutput(empty_ks);
+
+    zeInfoContainer full_ks;
+    getFullZEInfo(full_ks);
+    match &= matchYAMLOutput(full_ks);
+
+    // fixed seed so that a failure can be reproduced
+    std::mt19937 rng(20210601);
+    const unsigned numRandom = 1000;
+    for (unsigned i = 0; i < numRandom && match; ++i) {
+        zeInfoContainer rand_ks;
+        getRandomZEInfo(rng, rand_ks);
+        if (!matchYAMLOutput(rand_ks)) {
+            std::cout << "random zeInfo " << i << " mismatch\n";
+            match = false;
+        }
+    }
+    return match;
 }
 
 void Tester::testELFOutput()
 {
-    TargetFlags flag;
-    flag.packed = 10;
-    ZEELFObjectBuilder builder(false, ET_ZEBIN_EXE, 0, flag);
+    ZEELFObjectBuilder builder(false);
 
     // add fake text
     uint8_t text_buff[100] = { 0x1, 0x2, 0x3, 0x4 };
     uint32_t text =
-        builder.addSectionText(".text.kernel", (uint8_t*)text_buff, 10, 0, 0);
+        builder.addSectionText("kernel", (uint8_t*)text_buff, 10, 0, 0);
 
     // add fake data 1
     uint8_t data_buff_1[4] = { 0x1, 0x2, 0x3, 0x4 };
-    uint32_t data1 = builder.addSectionData(".data.buff_1", data_buff_1, 4);
+    uint32_t data1 = builder.addSectionData("buff_1", data_buff_1, 4);
 
     // add fake data 2
     uint8_t data_buff_2[2] = { 0x5, 0x6 };
-    uint32_t data2 = builder.addSectionData(".data.buff_2", data_buff_2, 2);
+    uint32_t data2 = builder.addSectionData("buff_2", data_buff_2, 2);
 
     // add fake symbols to text
     builder.addSymbol("text_sym_at_0", 0, 15, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT, text);
@@ -156,8 +391,8 @@ void Tester::testELFOutput()
     builder.addSymbol("undef_sym", 0, 0, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT, -1);
 
     // add fake relocations
-    builder.addRelocation(4, "data1_sym_at_3", R_TYPE_ZEBIN::R_ZE_SYM_ADDR, text);
-    builder.addRelocation(8, "text_sym_at_1", R_TYPE_ZEBIN::R_ZE_SYM_ADDR_32, text);
+    builder.addRelRelocation(4, "data1_sym_at_3", R_TYPE_ZEBIN::R_ZE_SYM_ADDR, text);
+    builder.addRelRelocation(8, "text_sym_at_1", R_TYPE_ZEBIN::R_ZE_SYM_ADDR_32, text);
 
     // add fake ze_info
     zeInfoContainer ks;
@@ -169,3 +404,88 @@ void Tester::testELFOutput()
     builder.finalize(os);
     os.close();
 }
+
+// add a kernel entry that resembles what IGC emits for an OpenCL kernel
+static void addSyntheticKernelInfo(ZEInfoBuilder& zeInfo, const std::string& name, int args)
+{
+    zeInfoKernel& k = zeInfo.createKernel(name);
+    k.execution_env.grf_count = 128;
+    k.execution_env.simd_size = 16;
+    k.execution_env.has_no_stateless_write = true;
+    k.execution_env.required_work_group_size = { 64, 1, 1 };
+    ZEInfoBuilder::addPerThreadPayloadArgument(k.per_thread_payload_arguments,
+        PreDefinedAttrGetter::ArgType::packed_local_ids, 0, 6);
+    ZEInfoBuilder::addPayloadArgumentImplicit(k.payload_arguments,
+        PreDefinedAttrGetter::ArgType::global_id_offset, 0, 12);
+    ZEInfoBuilder::addPayloadArgumentImplicit(k.payload_arguments,
+        PreDefinedAttrGetter::ArgType::local_size, 12, 12);
+    for (int i = 0; i < args; ++i) {
+        ZEInfoBuilder::addPayloadArgumentByPointer(k.payload_arguments,
+            32 + 8 * i, 8, i,
+            PreDefinedAttrGetter::ArgAddrMode::stateless,
+            PreDefinedAttrGetter::ArgAddrSpace::global,
+            PreDefinedAttrGetter::ArgAccessType::readwrite);
+        ZEInfoBuilder::addBindingTableIndex(k.binding_table_indices, i, i);
+    }
+    ZEInfoBuilder::addScratchPerThreadMemoryBuffer(k.per_thread_memory_buffers,
+        PreDefinedAttrGetter::MemBufferUsage::private_space, 0, 256);
+}
+
+void Tester::benchmarkELFOutput(unsigned numKernels, unsigned iterations)
+{
+    std::vector<uint8_t> text(4096);
+    for (size_t i = 0; i < text.size(); ++i)
+        text[i] = (uint8_t)(i * 7);
+    std::vector<uint8_t> constData(1024, 0x5a);
+
+    double buildSecs = 0, finalizeSecs = 0;
+    llvm::SmallVector<char, 0> buf;
+    for (unsigned iter = 0; iter < iterations; ++iter) {
+        auto start = std::chrono::steady_clock::now();
+        ZEELFObjectBuilder builder(true);
+        ZEInfoBuilder zeInfo;
+
+        auto constSect = builder.addSectionData("const", constData.data(),
+            constData.size(), 0, 32);
+        auto globalSect = builder.addSectionBss("global", 4096, 0, 64);
+        builder.addSymbol("const_buf", 0, constData.size(),
+            llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT, constSect);
+        builder.addSymbol("global_buf", 0, 4096,
+            llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT, globalSect);
+
+        for (unsigned k = 0; k < numKernels; ++k) {
+            std::string name = "kernel_" + std::to_string(k);
+            auto textSect = builder.addSectionText(name, text.data(),
+                text.size() - 16 * (k % 8), 0, 64);
+            builder.addSymbol(name, 0, text.size(),
+                llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC, textSect);
+            builder.addSymbol("_entry_" + name, 0, 0,
+                llvm::ELF::STB_LOCAL, llvm::ELF::STT_NOTYPE, textSect);
+            builder.addRelaRelocation(64, "const_buf",
+                R_TYPE_ZEBIN::R_ZE_SYM_ADDR, 16, textSect);
+            builder.addRelRelocation(128, "global_buf",
+                R_TYPE_ZEBIN::R_ZE_SYM_ADDR_32, textSect);
+            builder.addRelRelocation(144, "global_buf",
+                R_TYPE_ZEBIN::R_ZE_SYM_ADDR_32_HI, textSect);
+            addSyntheticKernelInfo(zeInfo, name, 1 + k % 6);
+        }
+        builder.addSectionZEInfo(zeInfo.getZEInfoContainer());
+        auto built = std::chrono::steady_clock::now();
+
+        buf.clear();
+        llvm::raw_svector_ostream os(buf);
+        builder.finalize(os);
+        auto end = std::chrono::steady_clock::now();
+
+        buildSecs += std::chrono::duration<double>(built - start).count();
+        finalizeSecs += std::chrono::duration<double>(end - built).count();
+    }
+
+    std::cout << numKernels << " kernels x " << iterations << " iterations: "
+        << buf.size() << " bytes\n"
+        << "  build:    " << buildSecs << " s\n"
+        << "  finalize: " << finalizeSecs << " s\n";
+
+    std::ofstream out("benchELFOutput", std::ios::out | std::ios::binary);
+    out.write(buf.data(), buf.size());
+}
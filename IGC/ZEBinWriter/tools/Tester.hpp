@@ -19,8 +19,12 @@ namespace zebin {
 
 class Tester {
 public:
-    static void testZEInfoOutput();
+    // return true if ZEInfoWriter and llvm::yaml::Output agree
+    static bool testZEInfoOutput();
     static void testELFOutput();
+    // time building and writing a synthetic program with the given number
+    // of kernels, the last output is written into benchELFOutput file
+    static void benchmarkELFOutput(unsigned numKernels, unsigned iterations);
 };
 
 } // namespace zebin
@@ -10,7 +10,7 @@ SPDX-License-Identifier: MIT
 
 #include "Tester.hpp"
 #include <ZEInfo.hpp>
-#include <ZEinfoYAML.hpp>
+#include <ZEInfoYAML.hpp>
 
 #include <llvm/Object/ObjectFile.h>
 #include <llvm/Object/ELFObjectFile.h>
@@ -31,18 +31,24 @@ using namespace zebin;
 static void dumpZEInfo(std::unique_ptr<llvm::object::ObjectFile> object) {
     bool dump = false;
     for (auto sect : object->sections()) {
-        llvm::StringRef name;
-        sect.getName(name);
+        llvm::Expected<llvm::StringRef> name = sect.getName();
+        if (!name) {
+            llvm::consumeError(name.takeError());
+            continue;
+        }
 
-        if (name.compare(llvm::StringRef(".ze_info")))
+        if (name->compare(llvm::StringRef(".ze_info")))
             continue;
 
-        llvm::StringRef content;
-        sect.getContents(content);
+        llvm::Expected<llvm::StringRef> content = sect.getContents();
+        if (!content) {
+            llvm::consumeError(content.takeError());
+            continue;
+        }
 
         std::ofstream outfile;
         outfile.open("ze_info.dump", std::ios::out | std::ios::binary);
-        outfile.write(content.data(), content.size());
+        outfile.write(content->data(), content->size());
         outfile.close();
         if (dump)
             std::cerr << "Given ELF object has more than one .ze_info section";
@@ -61,16 +67,28 @@ static llvm::cl::opt<bool> DumpZEInfo ("info",
     llvm::cl::desc("Dump .ze_info section into ze_info.dump file"));
 
 static llvm::cl::opt<bool> RunTestZEInfo ("test-ze-info",
-    llvm::cl::desc("Run static zeinfo generating tests, print the result to std output"));
+    llvm::cl::desc("Check that the .ze_info writer matches llvm::yaml::Output, print the result to std output"));
+
+static llvm::cl::opt<unsigned> BenchELFKernels ("bench-elf",
+    llvm::cl::desc("Time building and writing a synthetic ELF with the given number of kernels"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<unsigned> BenchIterations ("bench-iterations",
+    llvm::cl::desc("Number of iterations for -bench-elf"),
+    llvm::cl::init(10));
 /// ----------------------------------------------------------------------- ///
 
 int zeinfo_reader_main(int argc, const char** argv) {
     llvm::cl::ParseCommandLineOptions(argc, argv);
 
     // run zeinfo generating tests
-    // FIXME: This is just a static test, need to be enhanced
     if (RunTestZEInfo) {
-        Tester::testZEInfoOutput();
+        return Tester::testZEInfoOutput() ? 0 : 1;
+    }
+
+    // run zebin writing benchmark
+    if (BenchELFKernels) {
+        Tester::benchmarkELFOutput(BenchELFKernels, BenchIterations);
         return 0;
     }
 
@@ -8,14 +8,18 @@ SPDX-License-Identifier: MIT
 
 #include <ZEELFObjectBuilder.hpp>
 #include <ZEInfo.hpp>
-#include <ZEInfoYAML.hpp>
+#include <ZEInfoWriter.hpp>
 
 #ifndef ZEBinStandAloneBuild
 #include "common/LLVMWarningsPush.hpp"
 #endif
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/EndianStream.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -24,7 +28,6 @@ SPDX-License-Identifier: MIT
 #endif
 
 #include <iostream>
-#include <tuple>
 #include "Probe/Assertion.h"
 
 namespace zebin {
@@ -32,6 +35,10 @@ namespace zebin {
 /// ELFWriter - A helper class to write ELF contents into given raw_pwrite_stream,
 ///             according to the given ZEELFObjectBuilder. This object should
 ///             only be used by ZEELFObjectBuilder
+///             The writer works in two passes: the first one computes every
+///             section's offset and size (and the string table), the second
+///             one fills a buffer of exactly the file size that is then written
+///             to the output stream at once.
 class ELFWriter {
 public:
     ELFWriter(llvm::raw_pwrite_stream& OS,
@@ -47,18 +54,24 @@ private:
     typedef ZEELFObjectBuilder::ZEInfoSection ZEInfoSection;
     typedef ZEELFObjectBuilder::RelocationListTy RelocationListTy;
     typedef std::map<ZEELFObjectBuilder::SectionID, uint32_t> SectionIndexMapTy;
-    typedef std::map<std::string, uint64_t> SymNameIndexMapTy;
+    // the keys refer to the symbol names owned by ZEELFObjectBuilder
+    typedef llvm::DenseMap<llvm::StringRef, uint64_t> SymNameIndexMapTy;
 
     struct SectionHdrEntry {
-        uint32_t name    = 0;
-        unsigned type    = 0;
-        uint64_t offset  = 0;
-        uint64_t size    = 0;
-        uint32_t link    = 0;
-        uint32_t info    = 0;
-        uint32_t entsize = 0;
+        uint32_t name      = 0;
+        unsigned type      = 0;
+        uint64_t flags     = 0;
+        uint64_t offset    = 0;
+        uint64_t size      = 0;
+        uint32_t link      = 0;
+        uint32_t info      = 0;
+        uint64_t addralign = 0;
+        uint32_t entsize   = 0;
 
         const Section* section = nullptr;
+        // zlib compressed contents of a SHF_COMPRESSED section, without the
+        // compression header
+        llvm::SmallVector<char, 0> compressed;
     };
     typedef std::vector<SectionHdrEntry> SectionHdrListTy;
 
@@ -66,28 +79,35 @@ private:
     // set m_SectionHdrEntries and adjust the section index, also create
     // strings for sections' name in StringTableBuilder
     void createSectionHdrEntries();
+    // set the offset, size and other attributes of all SectionHdrEntry, and
+    // finalize the string table. Return the section header's offset
+    uint64_t layoutSections();
+    // create the symbols' names in the string table and set m_SymNameIdxMap
+    void layoutSymTab();
     // write elf header
-    void writeHeader();
-    // write sections and set the attributes in SectionHdrEntry
+    void writeHeader(uint64_t sectHdrOff);
+    // write sections at the offsets computed in layoutSections
     void writeSections();
     // write a raw section
     uint64_t writeSectionData(const uint8_t* data, uint64_t size, uint32_t padding);
+    // compress the given .debug* section into entry.compressed and set its
+    // size and flags. Return false if the section is to be kept uncompressed,
+    // which includes any section that has relocations
+    bool compressSection(SectionHdrEntry& entry, const StandardSection& sect);
+    // write the compression header followed by the compressed contents
+    uint64_t writeCompressedSection(const SectionHdrEntry& entry, uint64_t uncompressedSize);
     // write symbol table section, return section size
     uint64_t writeSymTab();
     // write rel or rela relocation table section
     uint64_t writeRelocTab(const RelocationListTy& relocs, bool isRelFormat);
-    // write ze info section
-    uint64_t writeZEInfo();
     // write .note.intelgt.compat section
-    std::pair<uint64_t, uint64_t> writeCompatibilityNote();
-    // write string table
-    uint64_t writeStrTab();
+    uint64_t writeCompatibilityNote();
+    // size of .note.intelgt.compat section
+    uint64_t getCompatibilityNoteSize();
     // write section header
     void writeSectionHeader();
-    // write the section header's offset into ELF header
-    void writeSectionHdrOffset(uint64_t offset);
     // write number of zero bytes
-    void writePadding(uint32_t size);
+    void writePadding(uint64_t size);
 
     // The name writeWord seems confusing. Both ELF32 and ELF64 words are
     // uint32_t.
@@ -102,6 +122,9 @@ private:
 
     uint16_t numOfSections();
 
+    uint32_t getHeaderSize();
+    uint32_t getSectionHdrEntSize();
+
     // name is the string table index of the section name
     SectionHdrEntry& createSectionHdrEntry(
         const std::string& name, unsigned type, const Section* sect = nullptr);
@@ -123,6 +146,11 @@ private:
         uint64_t addralign, uint64_t entsize);
 
 private:
+    // the final output stream
+    llvm::raw_pwrite_stream& m_OS;
+    // the whole ELF file is written into m_Buffer first
+    llvm::SmallVector<char, 0> m_Buffer;
+    llvm::raw_svector_ostream m_BufferOS;
     llvm::support::endian::Writer m_W;
     llvm::StringTableBuilder m_StrTabBuilder{llvm::StringTableBuilder::ELF};
     ZEELFObjectBuilder& m_ObjBuilder;
@@ -135,6 +163,13 @@ private:
 
     // symbol name to symbol index mapping, for creating relocations
     SymNameIndexMapTy m_SymNameIdxMap;
+    // string table offsets of the symbols' names, in symbol table order
+    std::vector<uint32_t> m_SymNameOffsets;
+    // string table offset of the .note.intelgt.compat section's name
+    uint32_t m_CompatNoteNameOffset = 0;
+
+    // serialized .ze_info contents
+    std::string m_ZEInfo;
 
     // section information for constructing section header
     SectionHdrListTy m_SectionHdrEntries;
@@ -160,9 +195,11 @@ ZEELFObjectBuilder::addStandardSection(
         need_padding_for_align = 0;
 
     // total required padding is (padding + need_padding_for_align)
-    sections.emplace_back(
-        ZEELFObjectBuilder::StandardSection(sectName, data, size, type,
-            (need_padding_for_align + padding), m_sectionIdCount));
+    sections.emplace_back(std::move(sectName), data, size, type,
+        (need_padding_for_align + padding), m_sectionIdCount);
+    m_stdSectionIndex.resize(m_sectionIdCount + 1);
+    m_stdSectionIndex[m_sectionIdCount] =
+        std::make_pair(&sections, sections.size() - 1);
     ++m_sectionIdCount;
     return sections.back();
 }
@@ -292,34 +329,34 @@ void ZEELFObjectBuilder::addSymbol(
 {
     if (binding == llvm::ELF::STB_LOCAL)
         m_localSymbols.emplace_back(
-            ZEELFObjectBuilder::Symbol(name, addr, size, binding, type, sectionId));
+            std::move(name), addr, size, binding, type, sectionId);
     else
         m_globalSymbols.emplace_back(
-            ZEELFObjectBuilder::Symbol(name, addr, size, binding, type, sectionId));
+            std::move(name), addr, size, binding, type, sectionId);
 }
 
 ZEELFObjectBuilder::RelocSection&
 ZEELFObjectBuilder::getOrCreateRelocSection(SectionID targetSectId, bool isRelFormat)
 {
-    // linear search to see if there's existed reloc section with given target id and rel format
-    // reversely iterate that the latest added might hit first
-    for (RelocSectionListTy::reverse_iterator it = m_relocSections.rbegin();
-         it != m_relocSections.rend(); ++it) {
-        if ((*it).m_TargetID == targetSectId && (*it).isRelFormat() == isRelFormat)
-            return *it;
-    }
+    // see if there's existed reloc section with given target id and rel format
+    auto it = m_relocSectionIndex.find(std::make_pair(targetSectId, isRelFormat));
+    if (it != m_relocSectionIndex.end())
+        return m_relocSections[it->second];
+
     // if not found, create one
     // adjust the section name to be .rel.applyTargetName or .rela.applyTargetName
     // If the targt name is empty, we use the defualt name .rel/.rela as the section name
     // though in our case this should not happen
     std::string sectName;
-    std::string targetName = getSectionNameBySectionID(targetSectId);
+    const std::string& targetName = getSectionNameBySectionID(targetSectId);
     if (!targetName.empty())
         sectName = (isRelFormat? m_RelName : m_RelaName) + targetName;
     else
         sectName = isRelFormat? m_RelName : m_RelaName;
 
-    m_relocSections.emplace_back(RelocSection(m_sectionIdCount, targetSectId, sectName, isRelFormat));
+    m_relocSectionIndex.emplace(
+        std::make_pair(targetSectId, isRelFormat), m_relocSections.size());
+    m_relocSections.emplace_back(m_sectionIdCount, targetSectId, std::move(sectName), isRelFormat);
     ++m_sectionIdCount;
     return m_relocSections.back();
 }
@@ -329,8 +366,7 @@ void ZEELFObjectBuilder::addRelRelocation(
 {
     RelocSection& reloc_sect = getOrCreateRelocSection(sectionId, true);
     // create the relocation
-    reloc_sect.m_Relocations.emplace_back(
-        ZEELFObjectBuilder::Relocation(offset, symName, type));
+    reloc_sect.m_Relocations.emplace_back(offset, std::move(symName), type);
 }
 
 void ZEELFObjectBuilder::addRelaRelocation(
@@ -338,8 +374,7 @@ void ZEELFObjectBuilder::addRelaRelocation(
 {
     RelocSection& reloc_sect = getOrCreateRelocSection(sectionId, false);
     // create the relocation
-    reloc_sect.m_Relocations.emplace_back(
-        ZEELFObjectBuilder::Relocation(offset, symName, type, addend));
+    reloc_sect.m_Relocations.emplace_back(offset, std::move(symName), type, addend);
 }
 
 uint64_t ZEELFObjectBuilder::finalize(llvm::raw_pwrite_stream& os)
@@ -368,23 +403,15 @@ ZEELFObjectBuilder::getSectionIDBySectionName(const char* name)
     return 0;
 }
 
-std::string ZEELFObjectBuilder::getSectionNameBySectionID(SectionID id)
+const std::string& ZEELFObjectBuilder::getSectionNameBySectionID(SectionID id)
 {
-    // do linear search that we assume there won't be too many sections
-    for (StandardSection& sect : m_textSections) {
-        if (sect.id() == id)
-            return sect.m_sectName;
-    }
-    for (StandardSection& sect : m_dataAndbssSections) {
-        if (sect.id() == id)
-            return sect.m_sectName;
-    }
-    for (StandardSection& sect : m_otherStdSections) {
-        if (sect.id() == id)
-            return sect.m_sectName;
+    if (id >= 0 && (size_t)id < m_stdSectionIndex.size() &&
+        m_stdSectionIndex[id].first != nullptr) {
+        return (*m_stdSectionIndex[id].first)[m_stdSectionIndex[id].second].m_sectName;
     }
     IGC_ASSERT_MESSAGE(0, "getSectionNameBySectionID: invalid SectionID");
-    return "";
+    static const std::string empty;
+    return empty;
 }
 
 uint64_t ELFWriter::writeSectionData(const uint8_t* data, uint64_t size, uint32_t padding)
@@ -401,10 +428,59 @@ uint64_t ELFWriter::writeSectionData(const uint8_t* data, uint64_t size, uint32_
     return m_W.OS.tell() - start_off;
 }
 
-void ELFWriter::writePadding(uint32_t size)
+bool ELFWriter::compressSection(SectionHdrEntry& entry, const StandardSection& sect)
+{
+    if (!m_ObjBuilder.m_compressDebugSections ||
+        !StringRef(sect.m_sectName).startswith(".debug") ||
+        sect.m_data == nullptr || sect.m_padding != 0 || !zlib::isAvailable())
+        return false;
+
+    // Relocations apply to the uncompressed contents, and consumers such as
+    // the runtime patch .debug_info in place through .rela.debug_info, so a
+    // section with relocations is kept as it is
+    for (const RelocSection& relocSect : m_ObjBuilder.m_relocSections) {
+        if (relocSect.m_TargetID == sect.id() && !relocSect.m_Relocations.empty())
+            return false;
+    }
+
+    StringRef contents((const char*)sect.m_data, sect.m_size);
+    if (Error err = zlib::compress(contents, entry.compressed)) {
+        consumeError(std::move(err));
+        entry.compressed.clear();
+        return false;
+    }
+
+    uint64_t chdrSize = is64Bit() ? sizeof(ELF::Elf64_Chdr) : sizeof(ELF::Elf32_Chdr);
+    if (chdrSize + entry.compressed.size() >= sect.m_size) {
+        entry.compressed.clear();
+        return false;
+    }
+
+    entry.flags = ELF::SHF_COMPRESSED;
+    // the compression header has to be aligned to its word size
+    entry.addralign = is64Bit() ? 8 : 4;
+    entry.size = chdrSize + entry.compressed.size();
+    return true;
+}
+
+uint64_t ELFWriter::writeCompressedSection(const SectionHdrEntry& entry, uint64_t uncompressedSize)
+{
+    uint64_t start_off = m_W.OS.tell();
+
+    // Elf32_Chdr and Elf64_Chdr, the uncompressed data is byte aligned
+    m_W.write<uint32_t>(ELF::ELFCOMPRESS_ZLIB); // ch_type
+    if (is64Bit())
+        m_W.write<uint32_t>(0);                 // ch_reserved
+    writeWord(uncompressedSize);                // ch_size
+    writeWord(1);                               // ch_addralign
+    m_W.OS.write(entry.compressed.data(), entry.compressed.size());
+
+    return m_W.OS.tell() - start_off;
+}
+
+void ELFWriter::writePadding(uint64_t size)
 {
-    for (uint32_t i = 0; i < size; ++i)
-        m_W.write<uint8_t>(0x0);
+    m_W.OS.write_zeros(size);
 }
 
 uint32_t ELFWriter::getSymTabEntSize()
@@ -473,33 +549,54 @@ uint64_t ELFWriter::writeRelocTab(const RelocationListTy& relocs, bool isRelForm
 
     for (const ZEELFObjectBuilder::Relocation& reloc : relocs) {
         // the target symbol's name must have been added into symbol table
-        IGC_ASSERT(m_SymNameIdxMap.find(reloc.symName()) != m_SymNameIdxMap.end());
+        auto symIt = m_SymNameIdxMap.find(reloc.symName());
+        IGC_ASSERT(symIt != m_SymNameIdxMap.end());
+        uint64_t symIdx = symIt != m_SymNameIdxMap.end() ? symIt->second : 0;
 
         if (isRelFormat)
-            writeRelRelocation(
-                reloc.offset(), reloc.type(), m_SymNameIdxMap[reloc.symName()]);
+            writeRelRelocation(reloc.offset(), reloc.type(), symIdx);
         else
             writeRelaRelocation(
-                reloc.offset(), reloc.type(), m_SymNameIdxMap[reloc.symName()], reloc.addend());
+                reloc.offset(), reloc.type(), symIdx, reloc.addend());
     }
 
     return m_W.OS.tell() - start_off;
 }
 
+void ELFWriter::layoutSymTab()
+{
+    size_t numSyms =
+        m_ObjBuilder.m_localSymbols.size() + m_ObjBuilder.m_globalSymbols.size();
+    m_SymNameOffsets.reserve(numSyms);
+    m_SymNameIdxMap.reserve(numSyms);
+
+    // index 0 is the null symbol
+    uint64_t symidx = 1;
+    auto addOneSym = [&](ZEELFObjectBuilder::Symbol& sym) {
+        // create symbol name entry in str table
+        m_SymNameOffsets.push_back(m_StrTabBuilder.add(StringRef(sym.name())));
+        // global symbol name must be unique
+        IGC_ASSERT(sym.binding() != llvm::ELF::STB_GLOBAL || m_SymNameIdxMap.find(sym.name()) == m_SymNameIdxMap.end());
+        m_SymNameIdxMap.insert(std::make_pair(StringRef(sym.name()), symidx));
+        ++symidx;
+    };
+
+    // the local symbols first, and then global symbols
+    for (ZEELFObjectBuilder::Symbol& sym : m_ObjBuilder.m_localSymbols)
+        addOneSym(sym);
+    for (ZEELFObjectBuilder::Symbol& sym : m_ObjBuilder.m_globalSymbols)
+        addOneSym(sym);
+}
+
 uint64_t ELFWriter::writeSymTab()
 {
     uint64_t start_off = m_W.OS.tell();
 
-    uint64_t symidx = 0;
-
     // index 0 is the null symbol
     writeSymbol(0, 0, 0, 0, 0, 0, ELF::SHN_UNDEF);
-    ++symidx;
 
+    size_t symidx = 0;
     auto writeOneSym = [&](ZEELFObjectBuilder::Symbol& sym) {
-        // create symbol name entry in str table
-        uint32_t nameoff = m_StrTabBuilder.add(StringRef(sym.name()));
-
         uint16_t sect_idx = 0;
         if (sym.sectionId() >= 0) {
             // the given section's index must have been adjusted in
@@ -511,11 +608,8 @@ uint64_t ELFWriter::writeSymTab()
             sect_idx = ELF::SHN_UNDEF;
         }
 
-        writeSymbol(nameoff, sym.addr(), sym.size(), sym.binding(), sym.type(),
-            0, sect_idx);
-        // global symbol name must be unique
-        IGC_ASSERT(sym.binding() != llvm::ELF::STB_GLOBAL || m_SymNameIdxMap.find(sym.name()) == m_SymNameIdxMap.end());
-        m_SymNameIdxMap.insert(std::make_pair(sym.name(), symidx));
+        writeSymbol(m_SymNameOffsets[symidx], sym.addr(), sym.size(),
+            sym.binding(), sym.type(), 0, sect_idx);
         ++symidx;
     };
 
@@ -532,18 +626,25 @@ uint64_t ELFWriter::writeSymTab()
     return m_W.OS.tell() - start_off;
 }
 
-uint64_t ELFWriter::writeZEInfo()
-{
-    uint64_t start_off = m_W.OS.tell();
-    // serialize ze_info contents
-    llvm::yaml::Output yout(m_W.OS);
-    IGC_ASSERT(m_ObjBuilder.m_zeInfoSection);
-    yout << m_ObjBuilder.m_zeInfoSection->getZeInfo();
+// The notes in .note.intelgt.compat, all with a 4-byte descriptor
+static const uint32_t CompatNoteTypes[] = {
+    NT_INTELGT_PRODUCT_FAMILY,
+    NT_INTELGT_GFXCORE_FAMILY,
+    NT_INTELGT_TARGET_METADATA
+};
+static const StringRef CompatNoteOwner = "IntelGT";
 
-    return m_W.OS.tell() - start_off;
+uint64_t ELFWriter::getCompatibilityNoteSize()
+{
+    // namesz, descsz and type words, the name and the descriptor, with the
+    // name and descriptor aligned to 4
+    uint64_t noteSize = 3 * sizeof(uint32_t) +
+        llvm::alignTo(CompatNoteOwner.size() + 1, 4) +
+        llvm::alignTo(sizeof(uint32_t), 4);
+    return noteSize * (sizeof(CompatNoteTypes) / sizeof(CompatNoteTypes[0]));
 }
 
-std::pair<uint64_t, uint64_t> ELFWriter::writeCompatibilityNote() {
+uint64_t ELFWriter::writeCompatibilityNote() {
     auto padToRequiredAlign = [&]() {
         // The alignment of the Elf word, name and descriptor is 4.
         // Implementations differ from the specification here: in practice all
@@ -566,38 +667,23 @@ std::pair<uint64_t, uint64_t> ELFWriter::writeCompatibilityNote() {
         padToRequiredAlign();
     };
 
-    // Align the section offset to the required alignment first.
-    // TODO: Handle the section alignment in a more generic place..
-    padToRequiredAlign();
+    // the section offset is already aligned in layoutSections
     uint64_t start_off = m_W.OS.tell();
+    IGC_ASSERT(start_off % 4 == 0);
     // write NT_INTELGT_PRODUCT_FAMILY
-    writeOneNote("IntelGT",
+    writeOneNote(CompatNoteOwner,
                  static_cast<uint32_t>(m_ObjBuilder.m_productFamily),
-                 NT_INTELGT_PRODUCT_FAMILY);
+                 CompatNoteTypes[0]);
 
     // write NT_INTELGT_GFXCORE_FAMILY_
-    writeOneNote("IntelGT",
+    writeOneNote(CompatNoteOwner,
                  static_cast<uint32_t>(m_ObjBuilder.m_gfxCoreFamily),
-                 NT_INTELGT_GFXCORE_FAMILY);
+                 CompatNoteTypes[1]);
 
     // write NT_INTELGT_TARGET_METADATA
-    writeOneNote("IntelGT",
+    writeOneNote(CompatNoteOwner,
                  m_ObjBuilder.m_metadata.packed,
-                 NT_INTELGT_TARGET_METADATA);
-    return std::make_pair(start_off, m_W.OS.tell() - start_off);
-}
-
-uint64_t ELFWriter::writeStrTab()
-{
-    uint64_t start_off = m_W.OS.tell();
-
-    // at this point, all strings should be added. Finalized the string table
-    // and write it to OS
-    // must finalize it in order, that we take the offset of
-    // section and symbols' name when added
-    m_StrTabBuilder.finalizeInOrder();
-    m_StrTabBuilder.write(m_W.OS);
-
+                 CompatNoteTypes[2]);
     return m_W.OS.tell() - start_off;
 }
 
@@ -624,27 +710,32 @@ void ELFWriter::writeSectionHeader()
     // createSectionHdrEntries or writeSections
     for (SectionHdrEntry& entry : m_SectionHdrEntries) {
         writeSecHdrEntry(
-            entry.name, entry.type, 0, 0, entry.offset, entry.size, entry.link,
-            entry.info, 0, entry.entsize);
+            entry.name, entry.type, entry.flags, 0, entry.offset, entry.size, entry.link,
+            entry.info, entry.addralign, entry.entsize);
     }
 }
 
-void ELFWriter::writeSections()
+uint64_t ELFWriter::layoutSections()
 {
+    uint64_t offset = getHeaderSize();
     for (SectionHdrEntry& entry : m_SectionHdrEntries) {
-        entry.offset = m_W.OS.tell();
+        entry.offset = offset;
 
         switch(entry.type) {
         case ELF::SHT_PROGBITS:
-        case SHT_ZEBIN_SPIRV: {
+        case SHT_ZEBIN_SPIRV:
+        case SHT_ZEBIN_GTPIN_INFO:
+        case SHT_ZEBIN_VISAASM:
+        case SHT_ZEBIN_MISC: {
             IGC_ASSERT(nullptr != entry.section);
             IGC_ASSERT(entry.section->getKind() == Section::STANDARD);
             const StandardSection* const stdsect =
                 static_cast<const StandardSection*>(entry.section);
             IGC_ASSERT(nullptr != stdsect);
             IGC_ASSERT(stdsect->m_size + stdsect->m_padding);
-            entry.size = writeSectionData(
-                stdsect->m_data, stdsect->m_size, stdsect->m_padding);
+            entry.size = stdsect->m_size + stdsect->m_padding;
+            if (compressSection(entry, *stdsect))
+                entry.offset = llvm::alignTo(offset, entry.addralign);
             break;
         }
         case ELF::SHT_NOBITS: {
@@ -652,11 +743,13 @@ void ELFWriter::writeSections()
                 static_cast<const StandardSection*>(entry.section);
             IGC_ASSERT(nullptr != stdsect);
             entry.size = stdsect->m_size;
-            break;
+            // occupies no space in the file
+            continue;
         }
         case ELF::SHT_SYMTAB:
-            entry.size = writeSymTab();
+            layoutSymTab();
             entry.entsize = getSymTabEntSize();
+            entry.size = (m_SymNameOffsets.size() + 1) * entry.entsize;
             entry.link = m_StringTableIndex;
             // one greater than the last local symbol index, including the
             // first null symbol
@@ -670,16 +763,23 @@ void ELFWriter::writeSections()
             const RelocSection* const relocSec =
                 static_cast<const RelocSection*>(entry.section);
             IGC_ASSERT(nullptr != relocSec);
-            entry.size = writeRelocTab(relocSec->m_Relocations, relocSec->isRelFormat());
             entry.entsize = getRelocTabEntSize(relocSec->isRelFormat());
+            entry.size = relocSec->m_Relocations.size() * entry.entsize;
             break;
         }
         case SHT_ZEBIN_ZEINFO:
-            entry.size = writeZEInfo();
+            // serialize ze_info contents
+            IGC_ASSERT(m_ObjBuilder.m_zeInfoSection);
+            ZEInfoWriter::write(m_ObjBuilder.m_zeInfoSection->getZeInfo(), m_ZEInfo);
+            entry.size = m_ZEInfo.size();
             break;
 
         case ELF::SHT_STRTAB:
-            entry.size = writeStrTab();
+            // at this point, all strings should be added. Finalized the string
+            // table. Must finalize it in order, that we take the offset of
+            // section and symbols' name when added
+            m_StrTabBuilder.finalizeInOrder();
+            entry.size = m_StrTabBuilder.getSize();
             break;
 
         case ELF::SHT_NULL:
@@ -687,50 +787,87 @@ void ELFWriter::writeSections()
             entry.size =
                 (m_SectionHdrEntries.size() + 1) >= ELF::SHN_LORESERVE ?
                 (m_SectionHdrEntries.size() + 1) : 0;
+            // occupies no space in the file
+            continue;
+
+        case ELF::SHT_NOTE:
+            // .note.intelgt.compat is the only note section
+            IGC_ASSERT(entry.name == m_CompatNoteNameOffset);
+            // the note requires 4-byte alignment
+            entry.offset = llvm::alignTo(offset, 4);
+            entry.size = getCompatibilityNoteSize();
             break;
 
-        case ELF::SHT_NOTE: {
-            // Currently we don't seem to reorder strings in the .strtab, and
-            // the offset returned by LLVM StringTableBuilder::add() will still
-            // be valid, so the section name can be checked in this way. Other
-            // possibilities are creating a new section kind and set the
-            // appropriate section pointer, or emitting .strtab before the note
-            // section.
-            auto strtabSize = m_StrTabBuilder.getSize();
-            if (entry.name == m_StrTabBuilder.add(m_ObjBuilder.m_CompatNoteName)) {
-                IGC_ASSERT(entry.name < strtabSize);
-                std::tie(entry.offset, entry.size) = writeCompatibilityNote();
-                break;
-            }
-        }
-
         default:
             IGC_ASSERT(0);
             break;
         }
+        offset = entry.offset + entry.size;
     }
+    return offset;
 }
 
-void ELFWriter::writeSectionHdrOffset(uint64_t offset)
+void ELFWriter::writeSections()
 {
-    auto &stream = static_cast<raw_pwrite_stream &>(m_W.OS);
+    for (SectionHdrEntry& entry : m_SectionHdrEntries) {
+        uint64_t size = 0;
+        switch(entry.type) {
+        case ELF::SHT_PROGBITS:
+        case SHT_ZEBIN_SPIRV:
+        case SHT_ZEBIN_GTPIN_INFO:
+        case SHT_ZEBIN_VISAASM:
+        case SHT_ZEBIN_MISC: {
+            const StandardSection* const stdsect =
+                static_cast<const StandardSection*>(entry.section);
+            if (entry.flags & ELF::SHF_COMPRESSED) {
+                writePadding(entry.offset - m_W.OS.tell());
+                size = writeCompressedSection(entry, stdsect->m_size);
+                break;
+            }
+            IGC_ASSERT(m_W.OS.tell() == entry.offset);
+            size = writeSectionData(
+                stdsect->m_data, stdsect->m_size, stdsect->m_padding);
+            break;
+        }
+        case ELF::SHT_SYMTAB:
+            IGC_ASSERT(m_W.OS.tell() == entry.offset);
+            size = writeSymTab();
+            break;
 
-    if (is64Bit()) {
-        uint64_t Val =
-            support::endian::byte_swap<uint64_t>(offset, m_W.Endian);
-        stream.pwrite(reinterpret_cast<char *>(&Val), sizeof(Val),
-            offsetof(ELF::Elf64_Ehdr, e_shoff));
+        case ELF::SHT_REL:
+        case ELF::SHT_RELA: {
+            const RelocSection* const relocSec =
+                static_cast<const RelocSection*>(entry.section);
+            IGC_ASSERT(m_W.OS.tell() == entry.offset);
+            size = writeRelocTab(relocSec->m_Relocations, relocSec->isRelFormat());
+            break;
+        }
+        case SHT_ZEBIN_ZEINFO:
+            IGC_ASSERT(m_W.OS.tell() == entry.offset);
+            m_W.OS << m_ZEInfo;
+            size = m_ZEInfo.size();
+            break;
 
-    } else {
-        uint32_t Val =
-            support::endian::byte_swap<uint32_t>(
-                static_cast<uint32_t>(offset), m_W.Endian);
-        stream.pwrite(reinterpret_cast<char *>(&Val), sizeof(Val),
-            offsetof(ELF::Elf32_Ehdr, e_shoff));
+        case ELF::SHT_STRTAB:
+            IGC_ASSERT(m_W.OS.tell() == entry.offset);
+            m_StrTabBuilder.write(m_W.OS);
+            size = m_StrTabBuilder.getSize();
+            break;
+
+        case ELF::SHT_NOTE:
+            writePadding(entry.offset - m_W.OS.tell());
+            size = writeCompatibilityNote();
+            break;
+
+        default:
+            // NULL and NOBITS sections occupy no space in the file
+            continue;
+        }
+        IGC_ASSERT(size == entry.size);
     }
 }
 
-void ELFWriter::writeHeader()
+void ELFWriter::writeHeader(uint64_t sectHdrOff)
 {
     // e_ident[EI_MAG0] to e_ident[EI_MAG3]
     m_W.OS << ELF::ElfMagic;
@@ -762,22 +899,20 @@ void ELFWriter::writeHeader()
     // e_phoff, no program header
     writeWord(0);
 
-    // e_shoff, will write it later
-    writeWord(0);
+    // e_shoff
+    writeWord(sectHdrOff);
 
     // e_flags
     m_W.write<uint32_t>(0);
 
     // e_ehsize = ELF header size
-    m_W.write<uint16_t>(is64Bit() ?
-        sizeof(ELF::Elf64_Ehdr) : sizeof(ELF::Elf32_Ehdr));
+    m_W.write<uint16_t>(getHeaderSize());
 
     m_W.write<uint16_t>(0);          // e_phentsize = prog header entry size
     m_W.write<uint16_t>(0);          // e_phnum = # prog header entries = 0
 
     // e_shentsize
-    m_W.write<uint16_t>(is64Bit() ?
-        sizeof(ELF::Elf64_Shdr) : sizeof(ELF::Elf32_Shdr));
+    m_W.write<uint16_t>(getSectionHdrEntSize());
 
     // e_shnum
     m_W.write<uint16_t>(numOfSections());
@@ -792,22 +927,39 @@ uint16_t ELFWriter::numOfSections()
     return m_StringTableIndex + 1;
 }
 
+uint32_t ELFWriter::getHeaderSize()
+{
+    return is64Bit() ? sizeof(ELF::Elf64_Ehdr) : sizeof(ELF::Elf32_Ehdr);
+}
+
+uint32_t ELFWriter::getSectionHdrEntSize()
+{
+    return is64Bit() ? sizeof(ELF::Elf64_Shdr) : sizeof(ELF::Elf32_Shdr);
+}
+
 ELFWriter::ELFWriter(llvm::raw_pwrite_stream& OS,
                      ZEELFObjectBuilder& objBuilder)
-    : m_W(OS, llvm::support::little), m_ObjBuilder(objBuilder)
+    : m_OS(OS), m_BufferOS(m_Buffer), m_W(m_BufferOS, llvm::support::little),
+      m_ObjBuilder(objBuilder)
 {
 }
 
 uint64_t ELFWriter::write()
 {
-    uint64_t start = m_W.OS.tell();
     createSectionHdrEntries();
-    writeHeader();
+    uint64_t sectHdrOff = layoutSections();
+    uint64_t fileSize =
+        sectHdrOff + (uint64_t)m_SectionHdrEntries.size() * getSectionHdrEntSize();
+
+    m_Buffer.reserve(fileSize);
+    writeHeader(sectHdrOff);
     writeSections();
-    uint64_t sectHdrOff = m_W.OS.tell();
+    IGC_ASSERT(m_W.OS.tell() == sectHdrOff);
     writeSectionHeader();
-    writeSectionHdrOffset(sectHdrOff);
-    return m_W.OS.tell() - start;
+    IGC_ASSERT(m_Buffer.size() == fileSize);
+
+    m_OS.write(m_Buffer.data(), m_Buffer.size());
+    return m_Buffer.size();
 }
 
 ELFWriter::SectionHdrEntry& ELFWriter::createNullSectionHdrEntry()
@@ -904,7 +1056,8 @@ void ELFWriter::createSectionHdrEntries()
 
     // .note.intelgt.compat
     // Create the compatibility note section
-    createSectionHdrEntry(m_ObjBuilder.m_CompatNoteName, ELF::SHT_NOTE);
+    m_CompatNoteNameOffset =
+        createSectionHdrEntry(m_ObjBuilder.m_CompatNoteName, ELF::SHT_NOTE).name;
     ++index;
 
     // .strtab
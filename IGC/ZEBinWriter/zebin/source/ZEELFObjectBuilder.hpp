@@ -33,6 +33,7 @@ SPDX-License-Identifier: MIT
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace llvm {
@@ -57,6 +58,12 @@ public:
     ~ZEELFObjectBuilder() {}
 
     void setProductFamily(PRODUCT_FAMILY family) { m_productFamily = family; }
+
+    // compress the contents of the .debug* sections with zlib (SHF_COMPRESSED)
+    // when writing the ELF file. A section is kept uncompressed if LLVM is built
+    // without zlib, if it has relocations (e.g. .debug_info) or if compression
+    // does not make it smaller
+    void setCompressDebugSections(bool enable) { m_compressDebugSections = enable; }
     PRODUCT_FAMILY getProductFamily() const { return m_productFamily; }
 
     void setGfxCoreFamily(GFXCORE_FAMILY family) { m_gfxCoreFamily = family; }
@@ -225,7 +232,7 @@ private:
     public:
         StandardSection(std::string sectName, const uint8_t* data, uint64_t size,
             unsigned type, uint32_t padding, uint32_t id)
-            : Section(id), m_sectName(sectName), m_data(data), m_size(size), m_type(type),
+            : Section(id), m_sectName(std::move(sectName)), m_data(data), m_size(size), m_type(type),
               m_padding(padding)
         {}
 
@@ -260,7 +267,7 @@ private:
     public:
         Symbol(std::string name, uint64_t addr, uint64_t size, uint8_t binding,
             uint8_t type, SectionID sectionId)
-            : m_name(name), m_addr(addr), m_size(size), m_binding(binding),
+            : m_name(std::move(name)), m_addr(addr), m_size(size), m_binding(binding),
             m_type(type), m_sectionId(sectionId)
         {}
 
@@ -286,7 +293,7 @@ private:
     class Relocation {
     public:
         Relocation(uint64_t offset, std::string symName, R_TYPE_ZEBIN type, uint64_t addend = 0)
-            : m_offset(offset), m_symName(symName), m_type(type), m_addend(addend)
+            : m_offset(offset), m_symName(std::move(symName)), m_type(type), m_addend(addend)
         {}
 
         uint64_t            offset()  const { return m_offset;  }
@@ -308,7 +315,7 @@ private:
     class RelocSection : public Section {
     public:
         RelocSection(SectionID myID, SectionID targetID, std::string sectName, bool isRelFormat) :
-            Section(myID), m_TargetID(targetID), m_sectName(sectName), m_isRelFormat (isRelFormat)
+            Section(myID), m_TargetID(targetID), m_sectName(std::move(sectName)), m_isRelFormat (isRelFormat)
         {}
 
         Kind getKind() const { return RELOC; }
@@ -333,7 +340,7 @@ private:
     // isRelFormat - rel or rela relocation format
     RelocSection& getOrCreateRelocSection(SectionID targetSectId, bool isRelFormat);
 
-    std::string getSectionNameBySectionID(SectionID id);
+    const std::string& getSectionNameBySectionID(SectionID id);
 
 private:
     // place holder for section default name
@@ -356,6 +363,8 @@ private:
     // 32 or 64 bit object
     bool m_is64Bit;
 
+    bool m_compressDebugSections = false;
+
     // information used to generate .note.intelgt.compat
     PRODUCT_FAMILY m_productFamily = IGFX_UNKNOWN;
     GFXCORE_FAMILY m_gfxCoreFamily = IGFX_UNKNOWN_CORE;
@@ -366,6 +375,12 @@ private:
     StandardSectionListTy m_otherStdSections;
     RelocSectionListTy    m_relocSections; // rel and rela reloc sections
 
+    // SectionID to the standard section's list and its index in the list
+    // (the list is nullptr for non-standard sections)
+    std::vector<std::pair<StandardSectionListTy*, size_t>> m_stdSectionIndex;
+    // (target SectionID, isRelFormat) to the index in m_relocSections
+    std::map<std::pair<SectionID, bool>, size_t> m_relocSectionIndex;
+
     // current section id
     SectionID m_sectionIdCount = 0;
 
@@ -0,0 +1,300 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include <ZEInfoWriter.hpp>
+
+#ifndef ZEBinStandAloneBuild
+#include "common/LLVMWarningsPush.hpp"
+#endif
+
+#include "llvm/Support/YAMLParser.h"
+#include "llvm/Support/YAMLTraits.h"
+
+#ifndef ZEBinStandAloneBuild
+#include "common/LLVMWarningsPop.hpp"
+#endif
+
+#include <string>
+#include <vector>
+
+using namespace zebin;
+
+namespace {
+
+/// ZEInfoEmitter - emits the block style YAML of llvm::yaml::Output
+/// Every key of a mapping starts on its own line. A key is followed by its
+/// scalar value padded to the same column as llvm::yaml::Output does, or by
+/// a nested mapping/sequence indented by two more columns.
+class ZEInfoEmitter {
+public:
+    ZEInfoEmitter(std::string& out) : m_out(out) {}
+
+    void emit(const zeInfoContainer& info);
+
+private:
+    // start a new "key:" line at the given indent. If this is the first key
+    // of a sequence element, the line starts with the "- " marker instead
+    void beginKey(const char* key, size_t keyLen, unsigned indent) {
+        if (m_seqElemStart) {
+            m_out.append(indent - 2, ' ');
+            m_out += "- ";
+            m_seqElemStart = false;
+        } else {
+            m_out.append(indent, ' ');
+        }
+        m_out.append(key, keyLen);
+        m_out += ':';
+    }
+
+    // "key:" followed by the padding before a scalar value
+    template <size_t N>
+    void scalarKey(const char (&key)[N], unsigned indent) {
+        const size_t keyLen = N - 1;
+        beginKey(key, keyLen, indent);
+        // llvm::yaml::Output aligns the values to column 16 after the key
+        const size_t padTo = 16;
+        m_out.append(keyLen < padTo ? padTo - keyLen : 1, ' ');
+    }
+
+    // "key:" followed by a nested block
+    template <size_t N>
+    void containerKey(const char (&key)[N], unsigned indent) {
+        beginKey(key, N - 1, indent);
+        m_out += '\n';
+    }
+
+    void value(int64_t v) {
+        m_out += std::to_string(v);
+        m_out += '\n';
+    }
+    void value(bool v) {
+        m_out += v ? "true" : "false";
+        m_out += '\n';
+    }
+    void value(const std::string& s);
+
+    template <size_t N>
+    void mapRequired(const char (&key)[N], int32_t v, unsigned indent) {
+        scalarKey(key, indent);
+        value((int64_t)v);
+    }
+    template <size_t N>
+    void mapRequired(const char (&key)[N], const std::string& v, unsigned indent) {
+        scalarKey(key, indent);
+        value(v);
+    }
+    template <size_t N>
+    void mapOptional(const char (&key)[N], int32_t v, int32_t dflt, unsigned indent) {
+        if (v != dflt)
+            mapRequired(key, v, indent);
+    }
+    template <size_t N>
+    void mapOptional(const char (&key)[N], bool v, bool dflt, unsigned indent) {
+        if (v != dflt) {
+            scalarKey(key, indent);
+            value(v);
+        }
+    }
+    template <size_t N>
+    void mapOptional(const char (&key)[N], const std::string& v, unsigned indent) {
+        if (!v.empty())
+            mapRequired(key, v, indent);
+    }
+    // sequence of scalars in flow style (e.g. "key: [ 1, 2 ]"), wrapped
+    // after column 70 like llvm::yaml::Output; empty sequences are omitted
+    template <size_t N>
+    void mapOptional(const char (&key)[N], const std::vector<int32_t>& v, unsigned indent) {
+        if (v.empty())
+            return;
+        scalarKey(key, indent);
+        size_t lineStart = m_out.rfind('\n') + 1;
+        const size_t flowStart = m_out.size() - lineStart;
+        const size_t wrapColumn = 70;
+        m_out += "[ ";
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (i != 0)
+                m_out += ", ";
+            if (m_out.size() - lineStart > wrapColumn) {
+                m_out += '\n';
+                lineStart = m_out.size();
+                m_out.append(flowStart + 2, ' ');
+            }
+            m_out += std::to_string(v[i]);
+        }
+        m_out += " ]\n";
+    }
+    // sequence of mappings; empty sequences are omitted
+    template <size_t N, typename T>
+    void mapOptional(const char (&key)[N], const std::vector<T>& v, unsigned indent) {
+        if (v.empty())
+            return;
+        containerKey(key, indent);
+        for (const T& elem : v)
+            seqElem(elem, indent + 4);
+    }
+
+    // emit a mapping as an element of a sequence, keys are at the given indent
+    template <typename T>
+    void seqElem(const T& elem, unsigned indent) {
+        m_seqElemStart = true;
+        mapping(elem, indent);
+        if (m_seqElemStart) {
+            // all of the keys are defaulted
+            m_out.append(indent - 2, ' ');
+            m_out += "- {}\n";
+            m_seqElemStart = false;
+        }
+    }
+
+    void mapping(const zeInfoKernel& info, unsigned indent);
+    void mapping(const zeInfoExecutionEnv& info, unsigned indent);
+    void mapping(const zeInfoPayloadArgument& info, unsigned indent);
+    void mapping(const zeInfoPerThreadPayloadArgument& info, unsigned indent);
+    void mapping(const zeInfoBindingTableIndex& info, unsigned indent);
+    void mapping(const zeInfoPerThreadMemoryBuffer& info, unsigned indent);
+    void mapping(const zeInfoExperimentalProperties& info, unsigned indent);
+    void mapping(const zeInfoDebugEnv& info, unsigned indent);
+
+private:
+    std::string& m_out;
+    bool m_seqElemStart = false;
+};
+
+} // namespace
+
+void ZEInfoEmitter::value(const std::string& s)
+{
+    // the same quoting as llvm::yaml::Output::scalarString
+    if (s.empty()) {
+        m_out += "''\n";
+        return;
+    }
+    switch (llvm::yaml::needsQuotes(s)) {
+    case llvm::yaml::QuotingType::None:
+        m_out += s;
+        break;
+    case llvm::yaml::QuotingType::Single:
+        // a single quote is escaped by doubling it
+        m_out += '\'';
+        for (char c : s) {
+            if (c == '\'')
+                m_out += '\'';
+            m_out += c;
+        }
+        m_out += '\'';
+        break;
+    case llvm::yaml::QuotingType::Double:
+        m_out += '"';
+        m_out += llvm::yaml::escape(s, /* EscapePrintable= */ false);
+        m_out += '"';
+        break;
+    }
+    m_out += '\n';
+}
+
+void ZEInfoEmitter::emit(const zeInfoContainer& info)
+{
+    m_out += "---\n";
+    mapRequired("version", info.version, 0);
+    if (info.kernels.empty()) {
+        scalarKey("kernels", 0);
+        m_out += "[]\n";
+    } else {
+        mapOptional("kernels", info.kernels, 0);
+    }
+    m_out += "...\n";
+}
+
+void ZEInfoEmitter::mapping(const zeInfoKernel& info, unsigned indent)
+{
+    mapRequired("name", info.name, indent);
+    containerKey("execution_env", indent);
+    mapping(info.execution_env, indent + 2);
+    mapOptional("payload_arguments", info.payload_arguments, indent);
+    mapOptional("per_thread_payload_arguments", info.per_thread_payload_arguments, indent);
+    mapOptional("binding_table_indices", info.binding_table_indices, indent);
+    mapOptional("per_thread_memory_buffers", info.per_thread_memory_buffers, indent);
+    mapOptional("experimental_properties", info.experimental_properties, indent);
+    mapOptional("debug_env", info.debug_env, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoExecutionEnv& info, unsigned indent)
+{
+    mapOptional("barrier_count", info.barrier_count, 0, indent);
+    mapOptional("disable_mid_thread_preemption", info.disable_mid_thread_preemption, false, indent);
+    mapRequired("grf_count", info.grf_count, indent);
+    mapOptional("has_4gb_buffers", info.has_4gb_buffers, false, indent);
+    mapOptional("has_device_enqueue", info.has_device_enqueue, false, indent);
+    mapOptional("has_dpas", info.has_dpas, false, indent);
+    mapOptional("has_fence_for_image_access", info.has_fence_for_image_access, false, indent);
+    mapOptional("has_global_atomics", info.has_global_atomics, false, indent);
+    mapOptional("has_multi_scratch_spaces", info.has_multi_scratch_spaces, false, indent);
+    mapOptional("has_no_stateless_write", info.has_no_stateless_write, false, indent);
+    mapOptional("offset_to_skip_per_thread_data_load", info.offset_to_skip_per_thread_data_load, 0, indent);
+    mapOptional("offset_to_skip_set_ffid_gp", info.offset_to_skip_set_ffid_gp, 0, indent);
+    mapOptional("required_sub_group_size", info.required_sub_group_size, 0, indent);
+    mapOptional("required_work_group_size", info.required_work_group_size, indent);
+    mapRequired("simd_size", info.simd_size, indent);
+    mapOptional("slm_size", info.slm_size, 0, indent);
+    mapOptional("subgroup_independent_forward_progress", info.subgroup_independent_forward_progress, false, indent);
+    mapOptional("work_group_walk_order_dimensions", info.work_group_walk_order_dimensions, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoPayloadArgument& info, unsigned indent)
+{
+    mapRequired("arg_type", info.arg_type, indent);
+    mapRequired("offset", info.offset, indent);
+    mapRequired("size", info.size, indent);
+    mapOptional("arg_index", info.arg_index, -1, indent);
+    mapOptional("addrmode", info.addrmode, indent);
+    mapOptional("addrspace", info.addrspace, indent);
+    mapOptional("access_type", info.access_type, indent);
+    mapOptional("sampler_index", info.sampler_index, -1, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoPerThreadPayloadArgument& info, unsigned indent)
+{
+    mapRequired("arg_type", info.arg_type, indent);
+    mapRequired("offset", info.offset, indent);
+    mapRequired("size", info.size, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoBindingTableIndex& info, unsigned indent)
+{
+    mapRequired("bti_value", info.bti_value, indent);
+    mapRequired("arg_index", info.arg_index, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoPerThreadMemoryBuffer& info, unsigned indent)
+{
+    mapRequired("type", info.type, indent);
+    mapRequired("usage", info.usage, indent);
+    mapRequired("size", info.size, indent);
+    mapOptional("slot", info.slot, 0, indent);
+    mapOptional("is_simt_thread", info.is_simt_thread, false, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoExperimentalProperties& info, unsigned indent)
+{
+    mapOptional("has_non_kernel_arg_load", info.has_non_kernel_arg_load, -1, indent);
+    mapOptional("has_non_kernel_arg_store", info.has_non_kernel_arg_store, -1, indent);
+    mapOptional("has_non_kernel_arg_atomic", info.has_non_kernel_arg_atomic, -1, indent);
+}
+
+void ZEInfoEmitter::mapping(const zeInfoDebugEnv& info, unsigned indent)
+{
+    mapOptional("sip_surface_bti", info.sip_surface_bti, -1, indent);
+    mapOptional("sip_surface_offset", info.sip_surface_offset, -1, indent);
+}
+
+void ZEInfoWriter::write(const zeInfoContainer& zeInfo, std::string& out)
+{
+    // a kernel's entry is typically well below 2KB
+    out.reserve(out.size() + 64 + zeInfo.kernels.size() * 2048);
+    ZEInfoEmitter(out).emit(zeInfo);
+}
@@ -0,0 +1,38 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//===- ZEInfoWriter.hpp -----------------------------------------*- C++ -*-===//
+// ZE Binary Utilities
+//
+// \file
+// This file declares ZEInfoWriter for serializing .ze_info contents
+//===----------------------------------------------------------------------===//
+
+#ifndef ZE_INFO_WRITER_HPP
+#define ZE_INFO_WRITER_HPP
+
+#include <ZEInfo.hpp>
+
+#include <string>
+
+namespace zebin {
+
+/// ZEInfoWriter - Serialize a zeInfoContainer into .ze_info text
+/// The output is the same as what llvm::yaml::Output produces with the
+/// mappings in autogen/ZEInfoYAML.cpp, but it is written directly into a
+/// string instead of going through the generic YAML IO state machine.
+/// Any change to the mappings in ZEInfoYAML.cpp must be reflected here.
+class ZEInfoWriter {
+public:
+    // append the serialized zeInfo to out
+    static void write(const zeInfoContainer& zeInfo, std::string& out);
+};
+
+} // end namespace zebin
+
+#endif // ZE_INFO_WRITER_HPP
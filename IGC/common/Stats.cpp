@@ -555,6 +555,11 @@ TimeStats::~TimeStats()
 
 void TimeStats::recordVISATimers()
 {
+    // vISA timers map by position onto the TIME_VISA_* stats, which must
+    // end right before TIME_VISA_Unaccounted
+    IGC_ASSERT_MESSAGE(TIME_VISA_TOTAL + getTotalTimers() == TIME_VISA_Unaccounted,
+        "vISA timers and TIME_VISA_* stats are out of sync");
+
     // getTotalTimers() +1 because there is a unaccounted counter
     for (unsigned int i = 0; i < getTotalTimers(); ++i)
     {
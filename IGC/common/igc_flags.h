@@ -94,6 +94,7 @@ DECLARE_IGC_REGKEY(bool, DisableCodeSinking,            false, "Setting this to
 DECLARE_IGC_REGKEY(bool, DisableCodeSinkingInputVec,    false, "Setting this to 1/true disable sinking inputVec inst (test)", false)
 DECLARE_IGC_REGKEY(DWORD, LoopSinkMinSave,              5,  "If loop sink can have save more than this Minimum, do it; otherwise, skip", false)
 DECLARE_IGC_REGKEY(DWORD, LoopSinkThresholdDelta,       50,  "Do loop sink If the estimated register pressure is higher than this + #avaialble registers", false)
+DECLARE_IGC_REGKEY(bool, EnableLoopSinkRPE,            false, "Use RegisterEstimator to find loops whose max GRF pressure exceeds #available registers and sink loop invariants into them", false)
 DECLARE_IGC_REGKEY(bool, DisableCodeHoisting,           false, "Setting this to 1/true adds a compiler switch to disable code-hoisting", false)
 DECLARE_IGC_REGKEY(bool, DisableDeSSA,                  false, "Setting this to 1/true adds a compiler switch to disable optimized De-SSA", false)
 DECLARE_IGC_REGKEY(bool, EnableDeSSAWA,                 true,  "[tmp]Keep some piece of code to avoid perf regression", false)
@@ -293,6 +294,8 @@ DECLARE_IGC_REGKEY(bool, EnableRelocations,             false, "Setting this to
 DECLARE_IGC_REGKEY(bool, EnableWriteOldFPToStack,       true,  "Setting this to 1 (true) writes the caller frame's frame-pointer to the start of callee's frame on stack, to support stack walk", false)
 DECLARE_IGC_REGKEY(bool, ZeBinCompatibleDebugging,      true,  "Setting this to 1 (true) enables embed debug info in zeBinary", true)
 DECLARE_IGC_REGKEY(bool, DebugInfoEnforceAmd64EM,       false, "Enforces elf file with the debug infomation to have eMachine set to AMD64", false)
+DECLARE_IGC_REGKEY(bool, CompressDebugSections,         false, "Setting this to 1 (true) compresses the .debug_* sections of the ELF file with the debug information (SHF_COMPRESSED, zlib). Sections with relocations are left uncompressed", true)
+DECLARE_IGC_REGKEY(DWORD, DebugInfoEmitThreads,         1,     "Number of threads writing the per-kernel ELF files with the debug information. 1 writes them on the compiling thread, 0 uses the number of hardware threads", true)
 DECLARE_IGC_REGKEY(debugString, ExtraOCLOptions,        0,     "Extra options for OpenCL", true)
 DECLARE_IGC_REGKEY(debugString, ExtraOCLInternalOptions, 0,    "Extra internal options for OpenCL", true)
 DECLARE_IGC_REGKEY(bool, UseVISAVarNames,               false, "Make VISA generate names for virtual variables so they match with dbg file", true)
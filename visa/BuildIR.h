@@ -307,7 +307,8 @@ private:
     const TARGET_PLATFORM platform;
 
     //allocator pools
-    USE_DEF_ALLOCATOR     useDefAllocator;
+    UseDefNodePool        useDefNodePool;
+    USE_DEF_ALLOCATOR     useDefAllocator {&useDefNodePool};
 
     FINALIZER_INFO*       metaData = nullptr;
     CompilerStats         compilerStats;
@@ -472,6 +473,8 @@ public:
     std::stringstream& criticalMsgStream();
 
     const USE_DEF_ALLOCATOR& getAllocator() const { return useDefAllocator; }
+    // peak memory taken by the def-use chains of all instructions
+    size_t getUseDefBytes() const { return useDefNodePool.getArenaBytes(); }
 
     // Following enum describes layout of r125 on entry to a function.
     // Ret_IP and Ret_EM may be altered due to callees. They'll be
@@ -379,11 +379,10 @@ namespace {
     public:
 
         static void ANListReplace(ANList &anlist, ANode *from, ANode *to);
-        static void BBListReplace(BB_LIST &bblist, G4_BB *from, G4_BB *to);
+        static void BBListReplace(BB_EDGE_LIST &bblist, G4_BB *from, G4_BB *to);
         static BB_LIST_ITER findBB(BB_LIST *bblist, G4_BB *bb);
         static ANList::iterator findANode(ANList &anlist, ANode *nd);
         static void ANListErase(ANList &anlist, ANode *toBeErased);
-        static void BBListErase(BB_LIST &bblist, G4_BB *toBeErased);
 
         CFGStructurizer(FlowGraph *cfg) : CFG(cfg)
         {
@@ -538,14 +537,14 @@ void dumpbblist(BB_LIST* bblist)
             (*dumpOut) << " " << labelInst->getLabel() << ",";
         }
         (*dumpOut) << "  Preds:";
-        for (BB_LIST_ITER I = bb->Preds.begin(), E = bb->Preds.end();
+        for (BB_EDGE_LIST_ITER I = bb->Preds.begin(), E = bb->Preds.end();
             I != E; ++I)
         {
             G4_BB *pred = *I;
             (*dumpOut) << " " << pred->getId();
         }
         (*dumpOut) << "    Succs:";
-        for (BB_LIST_ITER I = bb->Succs.begin(), E = bb->Succs.end();
+        for (BB_EDGE_LIST_ITER I = bb->Succs.begin(), E = bb->Succs.end();
             I != E; ++I)
         {
             G4_BB *succ = *I;
@@ -1022,16 +1021,14 @@ void CFGStructurizer::preProcess()
         G4_Label *newLabel = newBB->getLabel();
 
         // Adjust BB's pred/succs
-        BB_LIST_ITER NextIT;
-        BB_LIST_ITER IT = B->Preds.begin();
-        BB_LIST_ITER IE = B->Preds.end();
-        for (NextIT = IT; IT != IE; IT = NextIT)
+        BB_EDGE_LIST_ITER IT = B->Preds.begin();
+        while (IT != B->Preds.end())
         {
-            ++NextIT;
             G4_BB* P = *IT;
             if (P->getId() >= B->getId())
             {
                 // keep the backward branch unchanged.
+                ++IT;
                 continue;
             }
             G4_INST* gotoInst = getGotoInst(P);
@@ -1040,6 +1037,7 @@ void CFGStructurizer::preProcess()
                 && P->getPhysicalSucc() != B)   // not fall-thru to B
             {
                 // Possible mixed goto/if-endif. Skip non-goto/non-jmpi edges.
+                ++IT;
                 continue;
             }
 
@@ -1058,10 +1056,10 @@ void CFGStructurizer::preProcess()
             }
 
             // the edge from B's Preds
-            B->Preds.erase(IT);
+            IT = B->Preds.erase(IT);
         }
         newBB->Succs.push_back(B);
-        B->Preds.push_front(newBB);
+        B->Preds.insert(B->Preds.begin(), newBB);
 
         // insert it into BBs
         CFG->insert(BI, newBB);
@@ -1149,7 +1147,7 @@ void CFGStructurizer::init()
         }
         else
         {
-            for (BB_LIST_ITER I = bb->Succs.begin(), E = bb->Succs.end(); I != E; ++I)
+            for (BB_EDGE_LIST_ITER I = bb->Succs.begin(), E = bb->Succs.end(); I != E; ++I)
             {
                 G4_BB *succ = *I;
                 ANode *succNode = &(anodeBBs.IDToANodeBB[succ->getId()]);
@@ -1368,7 +1366,7 @@ bool CFGStructurizer::getCGBegin(G4_BB *bb, CGList &cgs)
     ControlGraph *cg;
     bool isBegin = false;
     // Check if bb is a loop head
-    for (BB_LIST_ITER I = bb->Preds.begin(), E = bb->Preds.end(); I != E; ++I)
+    for (BB_EDGE_LIST_ITER I = bb->Preds.begin(), E = bb->Preds.end(); I != E; ++I)
     {
         G4_BB *pred = *I;
         G4_INST *gotoInst = getGotoInst(pred);
@@ -1451,9 +1449,9 @@ void CFGStructurizer::ANListReplace(ANList &anlist, ANode *from, ANode *to)
     }
 }
 
-void CFGStructurizer::BBListReplace(BB_LIST &bblist, G4_BB *from, G4_BB *to)
+void CFGStructurizer::BBListReplace(BB_EDGE_LIST &bblist, G4_BB *from, G4_BB *to)
 {
-    for (BB_LIST_ITER I = bblist.begin(), E = bblist.end(); I != E; ++I)
+    for (BB_EDGE_LIST_ITER I = bblist.begin(), E = bblist.end(); I != E; ++I)
     {
         G4_BB *tmp = *I;
         if (tmp == from)
@@ -1474,15 +1472,6 @@ void CFGStructurizer::ANListErase(ANList &anlist, ANode *toBeErased)
     }
 }
 
-void CFGStructurizer::BBListErase(BB_LIST &bblist, G4_BB *toBeErased)
-{
-    BB_LIST_ITER I = findBB(&bblist, toBeErased);
-    if (I != bblist.end())
-    {
-        bblist.erase(I);
-    }
-}
-
 // Given ranges [end, exit] and [end1, exit1], and
 //      end < exit && end1 < exit1
 // return the last two BBs of them. Note that the order is the
@@ -1930,7 +1919,7 @@ ANList::iterator CFGStructurizer::findANode(ANList& anlist, ANode *nd)
 // Return true if all preds of abb is inside node; false otherwise.
 bool CFGStructurizer::isANodeOnlyPred(G4_BB *abb, ANode *node)
 {
-    for (BB_LIST_ITER II = abb->Preds.begin(), IE = abb->Preds.end();
+    for (BB_EDGE_LIST_ITER II = abb->Preds.begin(), IE = abb->Preds.end();
         II != IE; ++II)
     {
         G4_BB *tmp = *II;
@@ -1973,17 +1962,18 @@ ANodeBB* CFGStructurizer::addLandingBB(
     setInsertAfterBB(newBB, insertAfterBB);
 
     // Adjust BB's pred/succs
-    BB_LIST_ITER BE = exitBB->Preds.end();
-    BB_LIST_ITER BI = exitBB->Preds.begin();
-    while (BI != BE)
+    BB_EDGE_LIST_ITER BI = exitBB->Preds.begin();
+    while (BI != exitBB->Preds.end())
     {
-        BB_LIST_ITER curr = BI;
-        ++BI;
-        G4_BB *bb = *curr;
+        G4_BB *bb = *BI;
         ANode *tmp = getANodeBB(bb);
-        if (node->isMember(tmp))
+        if (!node->isMember(tmp))
         {
-            BBListErase(exitBB->Preds, bb);
+            ++BI;
+        }
+        else
+        {
+            BI = exitBB->Preds.erase(BI);
             BBListReplace(bb->Succs, exitBB, newBB);
             newBB->Preds.push_back(bb);
             G4_INST *gotoInst = getGotoInst(bb);
@@ -2097,17 +2087,12 @@ ANode *CFGStructurizer::addSplitBBAtBegin(G4_BB *splitBB)
     setInsertAfterBB(newBB, insertAfter);
 
     // Adjust BB's pred/succs
-    newBB->Preds.splice(newBB->Preds.end(), splitBB->Preds);
+    newBB->Preds.insert(newBB->Preds.end(), splitBB->Preds.begin(), splitBB->Preds.end());
     splitBB->Preds.clear();
     splitBB->Preds.push_back(newBB);
     newBB->Succs.push_back(splitBB);
-    BB_LIST_ITER BE = newBB->Preds.end();
-    BB_LIST_ITER BI = newBB->Preds.begin();
-    while (BI != BE)
+    for (G4_BB *pred : newBB->Preds)
     {
-        BB_LIST_ITER curr = BI;
-        ++BI;
-        G4_BB *pred = *curr;
         BBListReplace(pred->Succs, splitBB, newBB);
         G4_INST *gotoInst = getGotoInst(pred);
         if (gotoInst)
@@ -2157,14 +2142,14 @@ ANode* CFGStructurizer::addSplitBBAtEnd(G4_BB *splitBB)
     setInsertAfterBB(newBB, splitBB);
 
     // Adjust splitBB's pred/succs
-    BB_LIST_ITER BE = splitBB->Succs.end();
-    BB_LIST_ITER BI = splitBB->Succs.begin();
+    BB_EDGE_LIST_ITER BE = splitBB->Succs.end();
+    BB_EDGE_LIST_ITER BI = splitBB->Succs.begin();
     for (; BI != BE; ++BI)
     {
         G4_BB *bb = *BI;
         BBListReplace(bb->Preds, splitBB, newBB);
     }
-    newBB->Succs.splice(newBB->Succs.end(), splitBB->Succs);
+    newBB->Succs.insert(newBB->Succs.end(), splitBB->Succs.begin(), splitBB->Succs.end());
     newBB->Preds.push_back(splitBB);
     splitBB->Succs.clear();
     splitBB->Succs.push_back(newBB);
@@ -2176,9 +2161,9 @@ ANode* CFGStructurizer::addSplitBBAtEnd(G4_BB *splitBB)
     }
 
     // insert it into BBs
-    BI = findBB(BBs, splitBB);
-    ++BI;
-    BBs->insert(BI, newBB);
+    BB_LIST_ITER iter = findBB(BBs, splitBB);
+    ++iter;
+    BBs->insert(iter, newBB);
     G4_BB *phySucc = splitBB->getPhysicalSucc();
     splitBB->setPhysicalSucc(newBB);
     newBB->setPhysicalPred(splitBB);
@@ -3034,7 +3019,7 @@ void CFGStructurizer::convertChildren(ANodeHG *nodehg, G4_BB *nextJoinBB)
         }
 
         // For loops, need to handle the backward goto and may insert join
-        for (BB_LIST_ITER I1 = begin->Preds.begin(), E1 = begin->Preds.end();
+        for (BB_EDGE_LIST_ITER I1 = begin->Preds.begin(), E1 = begin->Preds.end();
             I1 != E1; ++I1)
         {
             // Don't process loopWhileNode if it is as it has been processed
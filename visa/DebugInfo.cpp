@@ -883,10 +883,30 @@ void insertData(const void* ptr, unsigned size, FILE* f)
 
 void insertData(const void* ptr, unsigned size, std::vector<unsigned char>& vec)
 {
-    for (unsigned i = 0; i < size; ++i)
-    {
-        vec.push_back(*(((const unsigned char*)ptr) + i));
-    }
+    vec.insert(vec.end(), (const unsigned char*)ptr, (const unsigned char*)ptr + size);
+}
+
+// Only counts the bytes written, used to size the output buffer upfront
+struct DbgInfoSizeCounter
+{
+    size_t size = 0;
+};
+
+void insertData(const void* /*ptr*/, unsigned size, DbgInfoSizeCounter& counter)
+{
+    counter.size += size;
+}
+
+// Writes into a buffer sized with DbgInfoSizeCounter
+struct DbgInfoBufferWriter
+{
+    unsigned char* cur = nullptr;
+};
+
+void insertData(const void* ptr, unsigned size, DbgInfoBufferWriter& writer)
+{
+    memcpy_s(writer.cur, size, ptr, size);
+    writer.cur += size;
 }
 
 unsigned int populateMapDclName(VISAKernelImpl* kernel, std::map<G4_Declare*, std::pair<const char*, unsigned int>>& mapDclName)
@@ -971,13 +991,13 @@ uint32_t KernelDebugInfo::getVarIndex(G4_Declare* dcl)
 }
 
 template<class T>
-void emitDataName(const char* name, T& t)
+void emitDataName(const std::string& name, T& t)
 {
-    auto length = (uint16_t)strlen(name);
+    auto length = (uint16_t)name.size();
     // Length
     insertData(&length, sizeof(uint16_t), t);
     // Actual name
-    insertData(name, (uint32_t) (sizeof(uint8_t) * length), t);
+    insertData(name.data(), (uint32_t) (sizeof(uint8_t) * length), t);
 }
 
 template<class T>
@@ -998,10 +1018,10 @@ void emitDataUInt8(uint8_t data, T& t)
     insertData(&data, sizeof(uint8_t), t);
 }
 
-template<class T>
-void emitDataVarLiveInterval(VISAKernelImpl* visaKernel, LiveIntervalInfo* lrInfo, uint32_t i, uint16_t size, T& t)
+void populateVarLiveIntervals(VISAKernelImpl* visaKernel, LiveIntervalInfo* lrInfo, uint32_t i,
+    std::vector<GenDbgLiveInterval>& lrsOut)
 {
-    // given lrs and saverestore, prepare assembled list of ranges to write out
+    // given lrs and saverestore, prepare assembled list of ranges
     KernelDebugInfo* dbgInfo = visaKernel->getKernel()->getKernelDebugInfo();
 
     // start cisa index, end cisa index
@@ -1010,64 +1030,38 @@ void emitDataVarLiveInterval(VISAKernelImpl* visaKernel, LiveIntervalInfo* lrInf
     {
         lrInfo->getLiveIntervals(lrs);
     }
-    uint16_t numLRs = (uint16_t)lrs.size();
     std::sort(lrs.begin(), lrs.end(), [](std::pair<uint32_t, uint32_t>& a, std::pair<uint32_t, uint32_t>& b) { return a.first < b.first; });
-    emitDataUInt16(numLRs, t);
+
+    auto& varsMap = dbgInfo->getVarsMap();
+    lrsOut.reserve(lrsOut.size() + lrs.size());
     for (auto& it : lrs)
     {
-        const uint32_t start = (uint32_t)it.first;
-        const uint32_t end = (uint32_t)it.second;
+        GenDbgLiveInterval lr;
+        lr.start = it.first;
+        lr.end = it.second;
+        lr.var.virtualType = varsMap[i]->virtualType;
+        lr.var.physicalType = varsMap[i]->physicalType;
 
-        if (size == 2)
+        // If physical register assigned then record register number and
+        // sub-register number. Else record memory spill offset.
+        if (lr.var.physicalType == VARMAP_PREG_FILE_MEMORY)
         {
-            emitDataUInt16((uint16_t)start, t);
-            emitDataUInt16((uint16_t)end, t);
+            lr.var.mapping.memoryOffset = varsMap[i]->Mapping.Memory.memoryOffset;
+            lr.var.mapping.isAbs = !visaKernel->getKernel()->fg.getHasStackCalls();
         }
         else
         {
-            emitDataUInt32(start, t);
-            emitDataUInt32(end, t);
-        }
-
-        auto& varsMap = dbgInfo->getVarsMap();
-        const unsigned char virtualType = varsMap[i]->virtualType;
-        // Write virtual register type
-        emitDataUInt8((uint8_t)virtualType, t);
-
-        const unsigned char physicalType = varsMap[i]->physicalType;
-        // Write physical register type
-        emitDataUInt8((uint8_t)physicalType, t);
-
-        // If physical register assigned then write register number and
-        // sub-register number. Else write memory spill offset.
-        if (physicalType == VARMAP_PREG_FILE_MEMORY)
-        {
-            unsigned int memOffset = (unsigned int)varsMap[i]->Mapping.Memory.memoryOffset;
-            if (visaKernel->getKernel()->fg.getHasStackCalls() == false)
-            {
-                memOffset |= 0x80000000;
-            }
-            // Emit memory offset
-            emitDataUInt32((uint32_t)memOffset, t);
-        }
-        else
-        {
-            const unsigned int regNum = varsMap[i]->Mapping.Register.regNum;
-            const unsigned int subRegNum = varsMap[i]->Mapping.Register.subRegNum;
-
-            // Emit register number
-            emitDataUInt16((uint16_t)regNum, t);
-
-            // Emit sub-register number
-            emitDataUInt16((uint16_t)subRegNum, t);
+            lr.var.mapping.regNum = varsMap[i]->Mapping.Register.regNum;
+            lr.var.mapping.subRegNum = varsMap[i]->Mapping.Register.subRegNum;
         }
+        lrsOut.push_back(lr);
     }
 }
 
-template<class T>
-void emitFrameDescriptorOffsetLiveInterval(LiveIntervalInfo* lrInfo, StackCall::FrameDescriptorOfsets memOffset, T& t)
+void populateFrameDescriptorOffsetLiveInterval(LiveIntervalInfo* lrInfo, StackCall::FrameDescriptorOfsets memOffset,
+    std::vector<GenDbgLiveInterval>& lrsOut)
 {
-    // Used to emit fields of Frame Descriptor
+    // Used for fields of Frame Descriptor
     // location = [start, end) @ BE_FP+offset
     std::vector<std::pair<uint32_t, uint32_t>> lrs;
     if (lrInfo)
@@ -1075,25 +1069,17 @@ void emitFrameDescriptorOffsetLiveInterval(LiveIntervalInfo* lrInfo, StackCall::
     else
         return;
 
-    uint32_t start = 0, end = 0;
+    GenDbgLiveInterval lr;
     if (lrs.size() > 0)
     {
-        start = lrs.front().first;
-        end = lrs.back().second;
+        lr.start = lrs.front().first;
+        lr.end = lrs.back().second;
     }
 
-    std::sort(lrs.begin(), lrs.end(), [](std::pair<uint32_t, uint32_t>& a, std::pair<uint32_t, uint32_t>& b) { return a.first < b.first; });
-
-    emitDataUInt16(1, t);
-
-    emitDataUInt32(start, t);
-    emitDataUInt32(end, t);
-
-    emitDataUInt8((uint8_t)VARMAP_PREG_FILE_GRF, t);
-
-    emitDataUInt8((uint8_t)VARMAP_PREG_FILE_MEMORY, t);
-
-    emitDataUInt32((uint32_t)memOffset, t);
+    lr.var.virtualType = VARMAP_VREG_FILE_GRF;
+    lr.var.physicalType = VARMAP_PREG_FILE_MEMORY;
+    lr.var.mapping.memoryOffset = (int32_t)memOffset;
+    lrsOut.push_back(lr);
 }
 
 void populateUniqueSubs(G4_Kernel* kernel, std::unordered_map<G4_BB*, bool>& uniqueSubs)
@@ -1120,16 +1106,15 @@ void populateUniqueSubs(G4_Kernel* kernel, std::unordered_map<G4_BB*, bool>& uni
     }
 }
 
-template<class T>
-void emitDataSubroutines(VISAKernelImpl* visaKernel, T& t)
+void populateSubroutines(VISAKernelImpl* visaKernel, std::vector<GenDbgSubroutineInfo>& subs)
 {
     auto kernel = visaKernel->getKernel();
-    // map<Label, Written to t>
+    // map<Label, Already recorded>
     std::unordered_map<G4_BB*, bool> uniqueSubs;
 
     populateUniqueSubs(kernel, uniqueSubs);
 
-    emitDataUInt16((uint16_t) uniqueSubs.size(), t);
+    subs.reserve(uniqueSubs.size());
 
     kernel->fg.setPhysicalPredSucc();
     for (auto bb : kernel->fg)
@@ -1171,67 +1156,62 @@ void emitDataSubroutines(VISAKernelImpl* visaKernel, T& t)
 
                     calleeBB = calleeBB->Preds.front();
                 }
-                emitDataName(subLabel->getLabel(), t);
-                emitDataUInt32(start, t);
-                emitDataUInt32(end, t);
+
+                GenDbgSubroutineInfo sub;
+                sub.name = subLabel->getLabel();
+                sub.startVISAIndex = start;
+                sub.endVISAIndex = end;
 
                 if (kernel->getKernelDebugInfo()->getLiveIntervalInfo(retval, false) != NULL)
                 {
                     auto lv = kernel->getKernelDebugInfo()->getLiveIntervalInfo(retval, false);
                     uint32_t idx = kernel->getKernelDebugInfo()->getVarIndex(retval);
-                    emitDataVarLiveInterval(visaKernel, lv, idx, sizeof(uint16_t), t);
+                    populateVarLiveIntervals(visaKernel, lv, idx, sub.retval);
                 }
+                subs.push_back(std::move(sub));
             }
         }
     }
 }
 
-template<class T>
-void emitDataPhyRegSaveInfoPerIP(VISAKernelImpl* visaKernel, SaveRestoreManager& mgr, T& t)
+void populatePhyRegSaveInfoPerIP(VISAKernelImpl* visaKernel, SaveRestoreManager& mgr,
+    std::vector<GenDbgPhyRegSaveInfoPerIP>& entries)
 {
     auto& srInfo = mgr.getSRInfo();
     auto relocOffset = visaKernel->getKernel()->getKernelDebugInfo()->getRelocOffset();
 
-    for (auto sr : srInfo)
+    for (auto& sr : srInfo)
     {
         if (sr.getInst()->getGenOffset() == UNDEFINED_GEN_OFFSET)
         {
             continue;
         }
 
-        emitDataUInt32((uint32_t)sr.getInst()->getGenOffset() +
-            getBinInstSize(sr.getInst()) - relocOffset, t);
-        emitDataUInt16((uint16_t) sr.saveRestoreMap.size(), t);
-        for (auto mapIt : sr.saveRestoreMap)
+        GenDbgPhyRegSaveInfoPerIP entry;
+        entry.genIPOffset = (uint32_t)sr.getInst()->getGenOffset() +
+            getBinInstSize(sr.getInst()) - relocOffset;
+        entry.data.reserve(sr.saveRestoreMap.size());
+        for (auto& mapIt : sr.saveRestoreMap)
         {
-            emitDataUInt16((uint16_t)mapIt.first * numEltPerGRF<Type_UB>(), t);
-            emitDataUInt16((uint16_t)numEltPerGRF<Type_UB>(), t);
+            GenDbgRegInfoMapping regInfo;
+            regInfo.srcRegOff = (uint16_t)mapIt.first * numEltPerGRF<Type_UB>();
+            regInfo.numBytes = (uint16_t)numEltPerGRF<Type_UB>();
 
             if (mapIt.second.first == SaveRestoreInfo::RegOrMem::Reg)
             {
-                emitDataUInt8((uint8_t)1, t);
-                emitDataUInt16((uint16_t)mapIt.second.second.regNum, t);
-                emitDataUInt16((uint16_t)0, t);
+                regInfo.dstInReg = true;
+                regInfo.dst.regNum = (uint16_t)mapIt.second.second.regNum;
+                regInfo.dst.subRegNum = 0;
             }
-            else if (mapIt.second.first == SaveRestoreInfo::RegOrMem::MemOffBEFP)
-            {
-                SaveRestoreInfo::RegMap tmp;
-                emitDataUInt8((uint8_t)0, t);
-                tmp = mapIt.second.second;
-                tmp.isAbs = 0;
-                uint32_t data = mapIt.second.second.memOff;
-                emitDataUInt32(data, t);
-            }
-            else if (mapIt.second.first == SaveRestoreInfo::RegOrMem::MemAbs)
+            else
             {
-                SaveRestoreInfo::RegMap tmp;
-                emitDataUInt8((uint8_t)0, t);
-                tmp = mapIt.second.second;
-                tmp.isAbs = 1;
-                uint32_t data = mapIt.second.second.memOff;
-                emitDataUInt32(data, t);
+                regInfo.dstInReg = false;
+                regInfo.dst.isAbs = mapIt.second.first == SaveRestoreInfo::RegOrMem::MemAbs;
+                regInfo.dst.memoryOffset = mapIt.second.second.memOff;
             }
+            entry.data.push_back(regInfo);
         }
+        entries.push_back(std::move(entry));
     }
 }
 
@@ -1334,13 +1314,10 @@ void SaveRestoreManager::sieveInstructions(CallerOrCallee c)
     }
 }
 
-template<class T>
-void emitDataCallerSave(VISAKernelImpl* visaKernel, T& t)
+void populateCallerSave(VISAKernelImpl* visaKernel, std::vector<GenDbgPhyRegSaveInfoPerIP>& entries)
 {
     auto kernel = visaKernel->getKernel();
 
-    uint16_t numCallerSaveEntries = 0;
-    // Compute total caller save entries to emit
     for (auto bbs : kernel->fg)
     {
         if (bbs->size() > 0 &&
@@ -1360,54 +1337,14 @@ void emitDataCallerSave(VISAKernelImpl* visaKernel, T& t)
                 mgr.addInst(callerRestore);
             }
 
-            auto& srInfo = mgr.getSRInfo();
-
             mgr.sieveInstructions(SaveRestoreManager::CallerOrCallee::Caller);
 
-            numCallerSaveEntries += (uint16_t) srInfo.size();
-            for (auto sr : srInfo)
-            {
-                if (sr.getInst()->getGenOffset() == UNDEFINED_GEN_OFFSET)
-                {
-                    numCallerSaveEntries--;
-                }
-            }
-        }
-    }
-
-    emitDataUInt16(numCallerSaveEntries, t);
-
-    if (numCallerSaveEntries > 0)
-    {
-        for (auto bbs : kernel->fg)
-        {
-            if (bbs->size() > 0 &&
-                kernel->getKernelDebugInfo()->isFcallWithSaveRestore(bbs))
-            {
-                auto& callerSaveInsts = kernel->getKernelDebugInfo()->getCallerSaveInsts(bbs);
-                auto& callerRestoreInsts = kernel->getKernelDebugInfo()->getCallerRestoreInsts(bbs);
-
-                SaveRestoreManager mgr(visaKernel);
-                for (auto callerSave : callerSaveInsts)
-                {
-                    mgr.addInst(callerSave);
-                }
-
-                for (auto callerRestore : callerRestoreInsts)
-                {
-                    mgr.addInst(callerRestore);
-                }
-
-                mgr.sieveInstructions(SaveRestoreManager::CallerOrCallee::Caller);
-
-                emitDataPhyRegSaveInfoPerIP(visaKernel, mgr, t);
-            }
+            populatePhyRegSaveInfoPerIP(visaKernel, mgr, entries);
         }
     }
 }
 
-template<class T>
-void emitDataCalleeSave(VISAKernelImpl* visaKernel, T& t)
+void populateCalleeSave(VISAKernelImpl* visaKernel, std::vector<GenDbgPhyRegSaveInfoPerIP>& entries)
 {
     G4_Kernel* kernel = visaKernel->getKernel();
 
@@ -1422,33 +1359,17 @@ void emitDataCalleeSave(VISAKernelImpl* visaKernel, T& t)
         mgr.addInst(calleeRestore);
     }
 
-    uint16_t numCalleeSaveEntries = 0;
-    auto& srInfo = mgr.getSRInfo();
-
     mgr.sieveInstructions(SaveRestoreManager::CallerOrCallee::Callee);
 
-    numCalleeSaveEntries += (uint16_t) srInfo.size();
-    for (auto sr : srInfo)
-    {
-        if (sr.getInst()->getGenOffset() == UNDEFINED_GEN_OFFSET)
-        {
-            numCalleeSaveEntries--;
-        }
-    }
-
-    emitDataUInt16(numCalleeSaveEntries, t);
-
-    emitDataPhyRegSaveInfoPerIP(visaKernel, mgr, t);
+    populatePhyRegSaveInfoPerIP(visaKernel, mgr, entries);
 }
 
-template<class T>
-void emitDataCallFrameInfo(VISAKernelImpl* visaKernel, T& t)
+void populateCallFrameInfo(VISAKernelImpl* visaKernel, GenDbgCallFrameInfo& cfi)
 {
     // Compute both be fp of current frame and previous frame
     auto kernel = visaKernel->getKernel();
 
-    auto frameSize = kernel->getKernelDebugInfo()->getFrameSize();
-    emitDataUInt16((uint16_t)frameSize, t);
+    cfi.frameSize = (uint16_t)kernel->getKernelDebugInfo()->getFrameSize();
 
     auto befpDcl = kernel->getKernelDebugInfo()->getBEFP();
     if (befpDcl)
@@ -1456,19 +1377,11 @@ void emitDataCallFrameInfo(VISAKernelImpl* visaKernel, T& t)
         auto befpLIInfo = kernel->getKernelDebugInfo()->getLiveIntervalInfo(befpDcl, false);
         if (befpLIInfo)
         {
-            emitDataUInt8((uint8_t)1, t);
+            cfi.befpValid = true;
             uint32_t idx = kernel->getKernelDebugInfo()->getVarIndex(kernel->fg.framePtrDcl);
-            emitDataVarLiveInterval(visaKernel, befpLIInfo, idx, sizeof(uint32_t), t);
-        }
-        else
-        {
-            emitDataUInt8((uint8_t)0, t);
+            populateVarLiveIntervals(visaKernel, befpLIInfo, idx, cfi.befp);
         }
     }
-    else
-    {
-        emitDataUInt8((uint8_t)0, t);
-    }
 
     auto callerfpdcl = kernel->getKernelDebugInfo()->getCallerBEFP();
     if (callerfpdcl)
@@ -1476,18 +1389,10 @@ void emitDataCallFrameInfo(VISAKernelImpl* visaKernel, T& t)
         auto callerfpLIInfo = kernel->getKernelDebugInfo()->getLiveIntervalInfo(callerfpdcl, false);
         if (callerfpLIInfo)
         {
-            emitDataUInt8((uint8_t)1, t);
+            cfi.callerbefpValid = true;
             // Caller's be_fp is stored in frame descriptor
-            emitFrameDescriptorOffsetLiveInterval(callerfpLIInfo, StackCall::FrameDescriptorOfsets::BE_FP, t);
+            populateFrameDescriptorOffsetLiveInterval(callerfpLIInfo, StackCall::FrameDescriptorOfsets::BE_FP, cfi.callerbefp);
         }
-        else
-        {
-            emitDataUInt8((uint8_t)0, t);
-        }
-    }
-    else
-    {
-        emitDataUInt8((uint8_t)0, t);
     }
 
     auto fretVar = kernel->getKernelDebugInfo()->getFretVar();
@@ -1496,198 +1401,324 @@ void emitDataCallFrameInfo(VISAKernelImpl* visaKernel, T& t)
         auto fretVarLIInfo = kernel->getKernelDebugInfo()->getLiveIntervalInfo(fretVar, false);
         if (fretVarLIInfo)
         {
-            emitDataUInt8((uint8_t)1, t);
-            emitFrameDescriptorOffsetLiveInterval(fretVarLIInfo, StackCall::FrameDescriptorOfsets::Ret_IP, t);
-        }
-        else
-        {
-            emitDataUInt8((uint8_t)0, t);
+            cfi.retAddrValid = true;
+            populateFrameDescriptorOffsetLiveInterval(fretVarLIInfo, StackCall::FrameDescriptorOfsets::Ret_IP, cfi.retAddr);
         }
     }
-    else
-    {
-        emitDataUInt8((uint8_t)0, t);
-    }
 
-    emitDataCalleeSave(visaKernel, t);
+    populateCalleeSave(visaKernel, cfi.calleeSaveEntry);
 
-    emitDataCallerSave(visaKernel, t);
+    populateCallerSave(visaKernel, cfi.callerSaveEntry);
 }
 
-// compilationUnits has 1 kernel and stack call functions
-// referenced by it. In case stack call functions dont
-// exist in input, it only has a kernel.
-template<class T>
-void emitData(std::list<VISAKernelImpl*>& compilationUnits, T t)
+void populateCompiledObj(VISAKernelImpl* curKernel, GenDbgCompiledObj& obj)
 {
-    const unsigned int magic = DEBUG_MAGIC_NUMBER;
-    const unsigned int numKernels = (uint32_t) compilationUnits.size();
-    // Magic
-    emitDataUInt32((uint32_t)magic, t);
-    // Num Kernels
-    emitDataUInt16((uint16_t)numKernels, t);
+    KernelDebugInfo* dbgInfo = curKernel->getKernel()->getKernelDebugInfo();
+
+    obj.kernelName = curKernel->getName();
 
-    auto cunitsItEnd = compilationUnits.end();
-    for (auto cunitsIt = compilationUnits.begin();
-        cunitsIt != cunitsItEnd;
-        cunitsIt++)
+    uint32_t reloc_offset = 0;
+    if (!curKernel->getIsKernel())
     {
-        VISAKernelImpl* curKernel = (*cunitsIt);
+        reloc_offset = dbgInfo->getRelocOffset();
+    }
+    obj.relocOffset = reloc_offset;
 
-        emitDataName(curKernel->getName(), t);
+    // CISA Offset:Gen Offset mapping
+    const auto& mapCISAOffsetGenOffset = dbgInfo->getMapCISAOffsetGenOffset();
+    obj.CISAOffsetMap.reserve(mapCISAOffsetGenOffset.size());
+    for (const auto& CisaOffset2Gen : mapCISAOffsetGenOffset)
+    {
+        obj.CISAOffsetMap.emplace_back(CisaOffset2Gen.CisaByteOffset, CisaOffset2Gen.GenOffset - reloc_offset);
+    }
 
-        uint32_t reloc_offset = 0;
-        if (curKernel->getIsKernel())
-        {
-            emitDataUInt32((uint32_t)reloc_offset, t);
-        }
-        else
+    // CISA index:Gen Offset mapping
+    const auto& mapCISAIndexGenOffset = dbgInfo->getMapCISAIndexGenOffset();
+    obj.CISAIndexMap.reserve(mapCISAIndexGenOffset.size());
+    for (const auto& CisaIndex2Gen : mapCISAIndexGenOffset)
+    {
+        obj.CISAIndexMap.emplace_back(CisaIndex2Gen.CisaIndex, CisaIndex2Gen.GenOffset - reloc_offset);
+    }
+
+    // All variables present in varMap need not be present in
+    // mapDclName. Only those variables seen when constructing
+    // symbol table will be added to mapDclName.
+    std::map<G4_Declare*, std::pair<const char*, unsigned int>> mapDclName;
+    populateMapDclName(curKernel, mapDclName);
+
+    // Virtual Register:Physical Register mapping elements
+    const auto& varsMap = dbgInfo->getVarsMap();
+    for (unsigned int i = 0, numElementsVarMap = (uint32_t)varsMap.size(); i < numElementsVarMap; i++)
+    {
+        G4_Declare* dcl = varsMap[i]->dcl;
+        auto dclNameIt = mapDclName.find(dcl);
+        if (dclNameIt == mapDclName.end())
         {
-            reloc_offset = curKernel->getKernel()->getKernelDebugInfo()->getRelocOffset();
-            emitDataUInt32((uint32_t)reloc_offset, t);
+            continue;
         }
 
-        // Emit CISA Offset:Gen Offset mapping
-        const unsigned int numElementsCISAOffsetMap = (uint32_t) curKernel->getKernel()->getKernelDebugInfo()->getMapCISAOffsetGenOffset().size();
-        // Num elements
-        emitDataUInt32((uint32_t)numElementsCISAOffsetMap, t);
+        const std::pair<const char*, unsigned int>& dclInfo = dclNameIt->second;
+        GenDbgVarInfo var;
+        var.name = dclInfo.first;
+        // to_string support not present prior to gcc 4.6 and is a c++11 feature
 
-        // Emit out actual CISA Offset:Gen Offset mapping elements
-        for (unsigned int i = 0; i < numElementsCISAOffsetMap; i++)
+#if ANDROID
         {
-            const auto & CisaOffset2Gen = curKernel->getKernel()->getKernelDebugInfo()->getMapCISAOffsetGenOffset()[i];
-            const unsigned int cisaOffset = CisaOffset2Gen.CisaByteOffset;
-            const unsigned int genOffset = CisaOffset2Gen.GenOffset - (unsigned int)reloc_offset;
+            char t_char[128];
+            snprintf(t_char, sizeof(t_char), "%d", dclInfo.second);
+            var.name += std::string(t_char);
+        }
+#elif defined(_MSC_VER) && _MSC_VER < 1700
+        var.name += std::to_string((_ULonglong)dclInfo.second);
+#else
+        var.name += std::to_string(dclInfo.second);
+#endif
 
-            // Write cisa offset and gen offset
-            emitDataUInt32((uint32_t)cisaOffset, t);
-            emitDataUInt32((uint32_t)genOffset, t);
+        if (curKernel->getOptions()->getOption(vISA_UseFriendlyNameInDbg))
+        {
+            var.name = dcl->getName();
         }
 
-        // Emit CISA index:Gen Offset mapping
-        const unsigned int numElementsCISAIndexMap = (uint32_t) curKernel->getKernel()->getKernelDebugInfo()->getMapCISAIndexGenOffset().size();
-        // Num elements
-        emitDataUInt32((uint32_t)numElementsCISAIndexMap, t);
+        // Insert live-interval information
+        LiveIntervalInfo* lrInfo = dbgInfo->getLiveIntervalInfo(dcl, false);
+        populateVarLiveIntervals(curKernel, lrInfo, i, var.lrs);
 
-        // Emit out actual CISA index:Gen Offset mapping
-        for (unsigned int i = 0; i < numElementsCISAIndexMap; i++)
-        {
-            const auto &CisaIndex2Gen = curKernel->getKernel()->getKernelDebugInfo()->getMapCISAIndexGenOffset()[i];
-            const unsigned int cisaIndex = CisaIndex2Gen.CisaIndex;
-            const unsigned int genOffset = CisaIndex2Gen.GenOffset - (unsigned int)reloc_offset;
+        obj.Vars.push_back(std::move(var));
+    }
 
-            // Write cisa index and gen offset
-            emitDataUInt32((uint32_t)cisaIndex, t);
-            emitDataUInt32((uint32_t)genOffset, t);
-        }
+    // sub-routine data
+    populateSubroutines(curKernel, obj.subs);
 
-        // All variables present in varMap need not be present in
-        // mapDclName. Only those variables seen when constructing
-        // symbol table will be added to mapDclName. So compute
-        // number of elements that will be written out.
-        unsigned int numItems = 0;
-        std::map<G4_Declare*, std::pair<const char*, unsigned int>> mapDclName;
-        // Compute items to write to debug info.
-        // Sum variables of all types present in symbol table
-        // created at build time, and subtract number of pre-
-        // defined variables.
-        populateMapDclName(curKernel, mapDclName);
+    populateCallFrameInfo(curKernel, obj.cfi);
+}
 
-        const unsigned int numElementsVarMap = (uint32_t) curKernel->getKernel()->getKernelDebugInfo()->getVarsMap().size();
+// compilationUnits has 1 kernel and stack call functions
+// referenced by it. In case stack call functions dont
+// exist in input, it only has a kernel.
+void populateDebugInfo(std::list<VISAKernelImpl*>& compilationUnits, GenDebugInfo& info)
+{
+    info.compiledObjs.clear();
+    info.compiledObjs.resize(compilationUnits.size());
 
-        for (unsigned int i = 0; i < numElementsVarMap; i++)
-        {
-            G4_Declare* dcl = curKernel->getKernel()->getKernelDebugInfo()->getVarsMap()[i]->dcl;
-            if (mapDclName.find(dcl) == mapDclName.end())
-            {
-                continue;
-            }
+    auto objIt = info.compiledObjs.begin();
+    for (VISAKernelImpl* curKernel : compilationUnits)
+    {
+        populateCompiledObj(curKernel, *objIt++);
+    }
+}
 
-            numItems++;
+void populateDebugInfo(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, GenDebugInfo& info)
+{
+    std::list<VISAKernelImpl*> compilationUnits;
+    compilationUnits.push_back(kernel);
+    auto funcItEnd = functions.end();
+    for (auto funcIt = functions.begin();
+        funcIt != funcItEnd;
+        funcIt++)
+    {
+        if ((*funcIt)->getKernel()->getKernelDebugInfo()->getRelocOffset() != 0)
+        {
+            // Include compilation unit only if
+            // it is referenced, ie reloc_offset
+            // for gen binary is non-zero.
+            compilationUnits.push_back((*funcIt));
         }
+    }
+#ifdef DEBUG_VERBOSE_ON
+    addCallFrameInfo(kernel);
 
-        // Emit out number of variable mapping items
-        emitDataUInt32((uint32_t)numItems, t);
+    for (auto& funcIt : functions)
+    {
+        addCallFrameInfo(funcIt);
+    }
+#endif
+
+    populateDebugInfo(compilationUnits, info);
+}
 
-        // Emit out actual Virtual Register:Physical Register mapping elements
-        for (unsigned int i = 0; i < numElementsVarMap; i++)
+template<class T>
+void emitDataVarAlloc(const GenDbgVarAlloc& var, T& t)
+{
+    // Write virtual register type
+    emitDataUInt8(var.virtualType, t);
+    // Write physical register type
+    emitDataUInt8(var.physicalType, t);
+
+    // If physical register assigned then write register number and
+    // sub-register number. Else write memory spill offset, its MSB
+    // is set when the offset is absolute.
+    if (var.isMemory())
+    {
+        uint32_t memOffset = (uint32_t)var.mapping.memoryOffset;
+        if (var.mapping.isAbs)
         {
-            G4_Declare* dcl = curKernel->getKernel()->getKernelDebugInfo()->getVarsMap()[i]->dcl;
-            if (mapDclName.find(dcl) == mapDclName.end())
-            {
-                continue;
-            }
+            memOffset |= 0x80000000;
+        }
+        emitDataUInt32(memOffset, t);
+    }
+    else
+    {
+        emitDataUInt16(var.mapping.regNum, t);
+        emitDataUInt16(var.mapping.subRegNum, t);
+    }
+}
 
-            const std::pair<const char*, unsigned int>& dclInfo = mapDclName.find(dcl)->second;
-            std::string varName(dclInfo.first);
-            // to_string support not present prior to gcc 4.6 and is a c++11 feature
+// size is the number of bytes of start/end, 2 for vISA indices
+// and 4 for gen offsets
+template<class T>
+void emitDataLiveIntervals(const std::vector<GenDbgLiveInterval>& lrs, uint16_t size, T& t)
+{
+    emitDataUInt16((uint16_t)lrs.size(), t);
+    for (const auto& lr : lrs)
+    {
+        if (size == 2)
+        {
+            emitDataUInt16((uint16_t)lr.start, t);
+            emitDataUInt16((uint16_t)lr.end, t);
+        }
+        else
+        {
+            emitDataUInt32(lr.start, t);
+            emitDataUInt32(lr.end, t);
+        }
+        emitDataVarAlloc(lr.var, t);
+    }
+}
 
-#if ANDROID
+template<class T>
+void emitDataPhyRegSaveInfo(const std::vector<GenDbgPhyRegSaveInfoPerIP>& entries, T& t)
+{
+    emitDataUInt16((uint16_t)entries.size(), t);
+    for (const auto& entry : entries)
+    {
+        emitDataUInt32(entry.genIPOffset, t);
+        emitDataUInt16((uint16_t)entry.data.size(), t);
+        for (const auto& regInfo : entry.data)
+        {
+            emitDataUInt16(regInfo.srcRegOff, t);
+            emitDataUInt16(regInfo.numBytes, t);
+            if (regInfo.dstInReg)
             {
-                char t_char[128];
-                snprintf(t_char, sizeof(t_char), "%d", dclInfo.second);
-                varName += std::string(t_char);
+                emitDataUInt8((uint8_t)1, t);
+                emitDataUInt16(regInfo.dst.regNum, t);
+                emitDataUInt16(regInfo.dst.subRegNum, t);
             }
-#elif defined(_MSC_VER) && _MSC_VER < 1700
-            varName += std::to_string((_ULonglong)dclInfo.second);
-#else
-            varName += std::to_string(dclInfo.second);
-#endif
-
-            if (curKernel->getOptions()->getOption(vISA_UseFriendlyNameInDbg))
+            else
             {
-                varName = dcl->getName();
+                // Format has no absolute bit for save locations
+                emitDataUInt8((uint8_t)0, t);
+                emitDataUInt32((uint32_t)regInfo.dst.memoryOffset, t);
             }
-            emitDataName(varName.c_str(), t);
-
-            // Insert live-interval information
-            LiveIntervalInfo* lrInfo = curKernel->getKernel()->getKernelDebugInfo()->getLiveIntervalInfo(dcl, false);
-            emitDataVarLiveInterval(curKernel, lrInfo, i, sizeof(uint16_t), t);
         }
-
-        // emit sub-routine data
-        emitDataSubroutines(curKernel, t);
-
-        emitDataCallFrameInfo(curKernel, t);
     }
 }
 
-void emitDebugInfo(VISAKernelImpl* curKernel, std::string filename)
+template<class T>
+void emitDataCallFrameInfo(const GenDbgCallFrameInfo& cfi, T& t)
 {
-    std::list<VISAKernelImpl*> functions;
-    emitDebugInfo(curKernel, functions, filename);
-}
+    emitDataUInt16(cfi.frameSize, t);
 
-extern "C" void* allocCodeBlock(size_t sz);
+    emitDataUInt8((uint8_t)cfi.befpValid, t);
+    if (cfi.befpValid)
+    {
+        emitDataLiveIntervals(cfi.befp, sizeof(uint32_t), t);
+    }
 
-void emitDebugInfoToMem(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, void*& info, unsigned& size)
+    emitDataUInt8((uint8_t)cfi.callerbefpValid, t);
+    if (cfi.callerbefpValid)
+    {
+        emitDataLiveIntervals(cfi.callerbefp, sizeof(uint32_t), t);
+    }
+
+    emitDataUInt8((uint8_t)cfi.retAddrValid, t);
+    if (cfi.retAddrValid)
+    {
+        emitDataLiveIntervals(cfi.retAddr, sizeof(uint32_t), t);
+    }
+
+    emitDataPhyRegSaveInfo(cfi.calleeSaveEntry, t);
+
+    emitDataPhyRegSaveInfo(cfi.callerSaveEntry, t);
+}
+
+// Serialize info into the binary format read by offline tools
+template<class T>
+void emitData(const GenDebugInfo& info, T t)
 {
-    std::vector<unsigned char>  vec;
-    std::list<VISAKernelImpl*> compilationUnits;
-    compilationUnits.push_back(kernel);
-    auto funcItEnd = functions.end();
-    for (auto funcIt = functions.begin();
-        funcIt != funcItEnd;
-        funcIt++)
+    const unsigned int magic = DEBUG_MAGIC_NUMBER;
+    const unsigned int numKernels = (uint32_t) info.compiledObjs.size();
+    // Magic
+    emitDataUInt32((uint32_t)magic, t);
+    // Num Kernels
+    emitDataUInt16((uint16_t)numKernels, t);
+
+    for (const auto& obj : info.compiledObjs)
     {
-        if ((*funcIt)->getKernel()->getKernelDebugInfo()->getRelocOffset() != 0)
+        emitDataName(obj.kernelName, t);
+        emitDataUInt32(obj.relocOffset, t);
+
+        // Emit CISA Offset:Gen Offset mapping
+        emitDataUInt32((uint32_t)obj.CISAOffsetMap.size(), t);
+        for (const auto& item : obj.CISAOffsetMap)
         {
-            compilationUnits.push_back((*funcIt));
+            emitDataUInt32(item.first, t);
+            emitDataUInt32(item.second, t);
+        }
+
+        // Emit CISA index:Gen Offset mapping
+        emitDataUInt32((uint32_t)obj.CISAIndexMap.size(), t);
+        for (const auto& item : obj.CISAIndexMap)
+        {
+            emitDataUInt32(item.first, t);
+            emitDataUInt32(item.second, t);
+        }
+
+        // Emit Virtual Register:Physical Register mapping
+        emitDataUInt32((uint32_t)obj.Vars.size(), t);
+        for (const auto& var : obj.Vars)
+        {
+            emitDataName(var.name, t);
+            emitDataLiveIntervals(var.lrs, sizeof(uint16_t), t);
+        }
+
+        // emit sub-routine data
+        emitDataUInt16((uint16_t)obj.subs.size(), t);
+        for (const auto& sub : obj.subs)
+        {
+            emitDataName(sub.name, t);
+            emitDataUInt32(sub.startVISAIndex, t);
+            emitDataUInt32(sub.endVISAIndex, t);
+            emitDataLiveIntervals(sub.retval, sizeof(uint16_t), t);
         }
+
+        emitDataCallFrameInfo(obj.cfi, t);
     }
+}
 
-    emitData<std::vector<unsigned char>&>(compilationUnits, vec);
+size_t getDebugInfoSize(const GenDebugInfo& info)
+{
+    DbgInfoSizeCounter counter;
+    emitData<DbgInfoSizeCounter&>(info, counter);
+    return counter.size;
+}
 
-    info = allocCodeBlock(vec.size());
-    memcpy_s(info, vec.size(), vec.data(), vec.size());
-    size = (uint32_t) vec.size();
+void emitDebugInfo(VISAKernelImpl* curKernel, std::string filename)
+{
+    std::list<VISAKernelImpl*> functions;
+    emitDebugInfo(curKernel, functions, filename);
 }
 
-void emitDebugInfoToMem(VISAKernelImpl* curKernel, void*& info, unsigned& size)
+extern "C" void* allocCodeBlock(size_t sz);
+
+void emitDebugInfoToMem(const GenDebugInfo& info, void*& buffer, unsigned& size)
 {
-    std::list<VISAKernelImpl*> compilationUnits;
+    size = (uint32_t)getDebugInfoSize(info);
+    buffer = allocCodeBlock(size);
 
-    emitDebugInfoToMem(curKernel, compilationUnits, info, size);
+    DbgInfoBufferWriter writer;
+    writer.cur = (unsigned char*)buffer;
+    emitData<DbgInfoBufferWriter&>(info, writer);
+    MUST_BE_TRUE(writer.cur == (unsigned char*)buffer + size, "Debug info size mismatch");
 }
 
 void* KernelDebugInfo::operator new(size_t sz, Mem_Manager& m)
@@ -1749,30 +1780,13 @@ void KernelDebugInfo::updateRelocOffset()
 
 void emitDebugInfo(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, std::string debugFileNameStr)
 {
-    std::list<VISAKernelImpl*> compilationUnits;
-    compilationUnits.push_back(kernel);
-    auto funcItEnd = functions.end();
-    for (auto funcIt = functions.begin();
-        funcIt != funcItEnd;
-        funcIt++)
-    {
-        if ((*funcIt)->getKernel()->getKernelDebugInfo()->getRelocOffset() != 0)
-        {
-            // Include compilation unit only if
-            // it is referenced, ie reloc_offset
-            // for gen binary is non-zero.
-            compilationUnits.push_back((*funcIt));
-        }
-    }
-#ifdef DEBUG_VERBOSE_ON
-    addCallFrameInfo(kernel);
-
-    for (auto& funcIt : functions)
-    {
-        addCallFrameInfo(funcIt);
-    }
-#endif
+    GenDebugInfo info;
+    populateDebugInfo(kernel, functions, info);
+    emitDebugInfo(info, debugFileNameStr);
+}
 
+void emitDebugInfo(const GenDebugInfo& info, std::string debugFileNameStr)
+{
     FILE* dbgFile = fopen(debugFileNameStr.c_str(), "wb+");
 
     if (dbgFile == NULL)
@@ -1781,7 +1795,7 @@ void emitDebugInfo(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions
         return;
     }
 
-    emitData(compilationUnits, dbgFile);
+    emitData(info, dbgFile);
 
     fclose(dbgFile);
 }
@@ -14,6 +14,7 @@ SPDX-License-Identifier: MIT
 #include "Common_BinaryEncoding.h"
 #include "RegAlloc.h"
 #include "GraphColor.h"
+#include "VISADebugInfo.h"
 #include <unordered_map>
 
 namespace vISA
@@ -38,8 +39,13 @@ DEBUG_RELEASE_INTERNAL_DLL_EXPORT_ONLY int decodeAndDumpDebugInfo(char* filename
 void emitDebugInfo(CISA_IR_Builder* builder, std::string filename);
 void emitDebugInfo(VISAKernelImpl* curKernel, std::string filename);
 void emitDebugInfo(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, std::string filename);
-void emitDebugInfoToMem(VISAKernelImpl* curKernel, void*& info, unsigned& size);
-void emitDebugInfoToMem(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, void*& info, unsigned& size);
+void emitDebugInfo(const vISA::GenDebugInfo& info, std::string filename);
+void emitDebugInfoToMem(const vISA::GenDebugInfo& info, void*& buffer, unsigned& size);
+// Collect debug info of kernel and of the referenced stack call functions
+// in functions without serializing it
+void populateDebugInfo(VISAKernelImpl* kernel, std::list<VISAKernelImpl*>& functions, vISA::GenDebugInfo& info);
+// Size of info in the binary format
+size_t getDebugInfoSize(const vISA::GenDebugInfo& info);
 
 void emitRegisterMapping(vISA::G4_Kernel& kernel, std::vector<VarnameMap*>& varsMap);
 
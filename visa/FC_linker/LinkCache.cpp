@@ -0,0 +1,253 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Cache of combined kernels.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "LinkCache.h"
+
+using namespace cm::patch;
+
+namespace {
+
+// Version of the combined binaries. Bump it with any change to the linker
+// that can change the combined binary of the same kernels and options, so
+// that the entries an older linker has stored are not reused.
+const uint32_t LinkerVersion = 1;
+
+// File layout: magic, the linker version, the key, the size of the binary and
+// the binary.
+const char CacheFileMagic[8] = {'C', 'M', 'F', 'C', 'L', 'N', 'K', '2'};
+
+// Limit of the combined binaries kept in memory. The oldest entries are
+// dropped first; they are still found in the directory, if there is one.
+const std::size_t MaxCachedBytes = std::size_t(64) << 20;
+
+unsigned long getProcessId() {
+#if defined(_WIN32)
+  return (unsigned long)_getpid();
+#else
+  return (unsigned long)getpid();
+#endif
+}
+
+/// Two independent 64-bit hashes, FNV-1a and a multiply-xorshift one, are
+/// computed over the same input to make up a 128-bit key.
+class KeyBuilder {
+  uint64_t H0 = 14695981039346656037ULL;
+  uint64_t H1 = 0x9e3779b97f4a7c15ULL;
+
+public:
+  void add(const char *Buf, std::size_t Sz) {
+    // The size is hashed too, so that the boundaries between the buffers
+    // are a part of the key.
+    addWord(uint64_t(Sz));
+    for (std::size_t i = 0; i != Sz; ++i)
+      H0 = (H0 ^ (unsigned char)Buf[i]) * 1099511628211ULL;
+    std::size_t i = 0;
+    for (; i + 8 <= Sz; i += 8) {
+      uint64_t W;
+      std::memcpy(&W, Buf + i, sizeof(W));
+      mix(W);
+    }
+    if (i != Sz) {
+      uint64_t Tail = 0;
+      std::memcpy(&Tail, Buf + i, Sz - i);
+      mix(Tail);
+    }
+  }
+
+  void addWord(uint64_t W) {
+    for (unsigned i = 0; i != 8; ++i, W >>= 8)
+      H0 = (H0 ^ (W & 0xff)) * 1099511628211ULL;
+    mix(W);
+  }
+
+  LinkCache::Key get() const { return LinkCache::Key{H0, H1}; }
+
+private:
+  void mix(uint64_t W) {
+    W *= 0xff51afd7ed558ccdULL;
+    W ^= W >> 33;
+    H1 = (H1 ^ W) * 0xc4ceb9fe1a85ec53ULL;
+    H1 ^= H1 >> 29;
+  }
+};
+
+} // End anonymous namespace
+
+LinkCache::Key LinkCache::getKey(std::size_t NumKernels,
+                                 const cm_fc_kernel_t *Kernels,
+                                 const char *Options) {
+  KeyBuilder KB;
+  KB.addWord(LinkerVersion);
+  KB.addWord(NumKernels);
+  for (std::size_t i = 0; i != NumKernels; ++i) {
+    KB.add(Kernels[i].patch_buf, Kernels[i].patch_size);
+    KB.add(Kernels[i].binary_buf, Kernels[i].binary_size);
+  }
+  if (Options)
+    KB.add(Options, std::strlen(Options));
+  else
+    KB.addWord(0);
+  return KB.get();
+}
+
+LinkCache &LinkCache::get() {
+  static LinkCache Cache;
+  return Cache;
+}
+
+void LinkCache::setEnabled(bool E, const char *D) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  Enabled = E;
+  Dir = D ? D : "";
+  if (!E) {
+    Entries.clear();
+    Order.clear();
+    CachedBytes = 0;
+  }
+}
+
+bool LinkCache::lookup(const Key &K, std::string &Linked) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  if (!Enabled)
+    return false;
+  auto I = Entries.find(K);
+  if (I != Entries.end()) {
+    Linked = I->second;
+    return true;
+  }
+  if (Dir.empty() || !readFile(K, Linked))
+    return false;
+  addEntry(K, Linked);
+  return true;
+}
+
+void LinkCache::insert(const Key &K, const std::string &Linked) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  if (!Enabled)
+    return;
+  if (Entries.count(K))
+    return;
+  addEntry(K, Linked);
+  if (!Dir.empty())
+    writeFile(K, Linked);
+}
+
+void LinkCache::addEntry(const Key &K, const std::string &Linked) {
+  if (Linked.size() > MaxCachedBytes)
+    return;
+  while (CachedBytes + Linked.size() > MaxCachedBytes) {
+    auto I = Entries.find(Order.front());
+    CachedBytes -= I->second.size();
+    Entries.erase(I);
+    Order.pop_front();
+  }
+  Entries.insert(std::make_pair(K, Linked));
+  Order.push_back(K);
+  CachedBytes += Linked.size();
+}
+
+std::string LinkCache::getPath(const Key &K) const {
+  char Name[40];
+  std::snprintf(Name, sizeof(Name), "%016llx%016llx.fcbin",
+                (unsigned long long)K.H0, (unsigned long long)K.H1);
+  std::string Path = Dir;
+  if (Path.back() != '/' && Path.back() != '\\')
+    Path += '/';
+  return Path + Name;
+}
+
+bool LinkCache::readFile(const Key &K, std::string &Linked) const {
+  std::ifstream IFS(getPath(K), std::ios::in | std::ios::binary);
+  if (!IFS.good())
+    return false;
+
+  char Magic[sizeof(CacheFileMagic)];
+  uint32_t Version = 0;
+  Key FileKey;
+  uint64_t Size = 0;
+  IFS.read(Magic, sizeof(Magic));
+  IFS.read(reinterpret_cast<char *>(&Version), sizeof(Version));
+  IFS.read(reinterpret_cast<char *>(&FileKey.H0), sizeof(FileKey.H0));
+  IFS.read(reinterpret_cast<char *>(&FileKey.H1), sizeof(FileKey.H1));
+  IFS.read(reinterpret_cast<char *>(&Size), sizeof(Size));
+  if (!IFS.good() ||
+      std::memcmp(Magic, CacheFileMagic, sizeof(Magic)) != 0 ||
+      Version != LinkerVersion || !(FileKey == K))
+    return false;
+
+  // Reject truncated or oversized files before allocating the buffer, as
+  // the size is only as good as the file.
+  std::streamoff Pos = IFS.tellg();
+  IFS.seekg(0, std::ios::end);
+  std::streamoff End = IFS.tellg();
+  if (Pos < 0 || End < Pos || uint64_t(End - Pos) != Size)
+    return false;
+  IFS.seekg(Pos);
+
+  std::string Buf;
+  try {
+    Buf.resize(std::size_t(Size));
+  } catch (const std::bad_alloc &) {
+    return false;
+  }
+  IFS.read(&Buf[0], std::streamsize(Size));
+  if (IFS.gcount() != std::streamsize(Size))
+    return false;
+
+  Linked.swap(Buf);
+  return true;
+}
+
+void LinkCache::writeFile(const Key &K, const std::string &Linked) const {
+  // Write into a temporary file first so that other processes never see a
+  // partially written entry.
+  std::string Path = getPath(K);
+  std::string TmpPath = Path + "." + std::to_string(getProcessId()) + "." +
+      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+      "." +
+      std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream OFS(TmpPath, std::ios::out | std::ios::binary);
+    if (!OFS.good())
+      return;
+    uint64_t Size = Linked.size();
+    OFS.write(CacheFileMagic, sizeof(CacheFileMagic));
+    OFS.write(reinterpret_cast<const char *>(&LinkerVersion),
+              sizeof(LinkerVersion));
+    OFS.write(reinterpret_cast<const char *>(&K.H0), sizeof(K.H0));
+    OFS.write(reinterpret_cast<const char *>(&K.H1), sizeof(K.H1));
+    OFS.write(reinterpret_cast<const char *>(&Size), sizeof(Size));
+    OFS.write(Linked.data(), std::streamsize(Linked.size()));
+    if (!OFS.good()) {
+      OFS.close();
+      std::remove(TmpPath.c_str());
+      return;
+    }
+  }
+  // Another process may have stored the same entry meanwhile, in which case
+  // the rename may fail on some systems and ours is simply dropped.
+  if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+    std::remove(TmpPath.c_str());
+}
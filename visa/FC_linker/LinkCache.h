@@ -0,0 +1,86 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Cache of combined kernels.
+//
+
+#pragma once
+
+#ifndef __CM_FC_LINK_CACHE_H__
+#define __CM_FC_LINK_CACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cm_fc_ld.h"
+
+namespace cm {
+namespace patch {
+
+/// LinkCache keeps the combined binaries keyed by a hash of the patch info
+/// and binaries of the kernels combined and of the link options. The entries
+/// are kept in memory, up to a limit, and, if a directory is given, also as
+/// files in that directory so that later processes combining the same kernels
+/// reuse them.
+///
+/// The files are only checked to be complete and to carry the key and linker
+/// version they are looked up with; their contents are trusted. The directory
+/// must be private to the user, as anyone who can write to it can substitute
+/// the combined binaries.
+///
+class LinkCache {
+public:
+  struct Key {
+    uint64_t H0;
+    uint64_t H1;
+
+    bool operator==(const Key &K) const { return H0 == K.H0 && H1 == K.H1; }
+  };
+
+  static Key getKey(std::size_t NumKernels, const cm_fc_kernel_t *Kernels,
+                    const char *Options);
+
+  /// Return the process-wide cache.
+  static LinkCache &get();
+
+  void setEnabled(bool E, const char *D);
+  bool isEnabled() const { return Enabled; }
+
+  /// Return true and fill @p Linked if the binary of @p K is cached.
+  bool lookup(const Key &K, std::string &Linked);
+  void insert(const Key &K, const std::string &Linked);
+
+private:
+  struct KeyHash {
+    std::size_t operator()(const Key &K) const { return std::size_t(K.H0); }
+  };
+
+  void addEntry(const Key &K, const std::string &Linked);
+  std::string getPath(const Key &K) const;
+  bool readFile(const Key &K, std::string &Linked) const;
+  void writeFile(const Key &K, const std::string &Linked) const;
+
+  std::mutex Lock;
+  std::atomic<bool> Enabled{false};
+  std::string Dir;
+  std::unordered_map<Key, std::string, KeyHash> Entries;
+  // Keys of Entries, oldest first.
+  std::list<Key> Order;
+  std::size_t CachedBytes = 0;
+};
+
+} // End namespace patch
+} // End namespace cm
+
+#endif // __CM_FC_LINK_CACHE_H__
@@ -14,6 +14,10 @@ SPDX-License-Identifier: MIT
 #include <cstdint>
 #include <cstdio>
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #include "cm_fc_ld.h"
 
 #include "DepGraph.h"
@@ -122,6 +126,37 @@ protected:
 
 } // End anonymous namespace
 
+void shiftRelocations(cm::patch::Binary &Bin,
+                      const std::vector<unsigned> &SyncSizes) {
+  assert(SyncSizes.size() == std::size_t(std::distance(Bin.sp_begin(),
+                                                       Bin.sp_end())) &&
+         "One size is expected per sync point!");
+  // Relocations in the order of their offsets, so that each one is moved
+  // by the sync instructions inserted before it in a single walk.
+  std::vector<cm::patch::Relocation *> Rels;
+  for (auto RI = Bin.rel_begin(), RE = Bin.rel_end(); RI != RE; ++RI)
+    Rels.push_back(&*RI);
+  std::stable_sort(Rels.begin(), Rels.end(),
+                   [](cm::patch::Relocation *A, cm::patch::Relocation *B) {
+                     return A->getOffset() < B->getOffset();
+                   });
+  auto NextRel = Rels.begin();
+  auto Size = SyncSizes.begin();
+  unsigned Inserted = 0;
+  for (auto SI = Bin.sp_begin(), SE = Bin.sp_end(); SI != SE; ++SI, ++Size) {
+    unsigned Offset = (*SI)->getOffset();
+    for (; NextRel != Rels.end() && (*NextRel)->getOffset() < Offset;
+         ++NextRel)
+      (*NextRel)->setOffset((*NextRel)->getOffset() + Inserted);
+    Inserted += *Size;
+  }
+  for (; NextRel != Rels.end(); ++NextRel) {
+    unsigned RelOff = (*NextRel)->getOffset();
+    if (RelOff < Bin.getSize())
+      (*NextRel)->setOffset(RelOff + Inserted);
+  }
+}
+
 bool linkPatchInfo(cm::patch::Collection &C,
                    std::size_t NumKernels, cm_fc_kernel_t *Kernels,
                    const char *Options) {
@@ -136,16 +171,13 @@ bool PatchInfoLinker::link(cm::patch::Collection &C) {
 
   Platform = C.getPlatform();
 
-  std::map<cm::patch::Binary *, cm::patch::Symbol *> BinMap;
-  // Setup mapping from binary to symbol.
+  // Name each binary by the symbol defined at its start.
   for (auto I = C.sym_begin(), E = C.sym_end(); I != E; ++I) {
     // Bail out if there's unresolved symbol.
     if (I->isUnresolved())
       return true;
-    if (I->getAddr() == 0) {
-      BinMap[I->getBinary()] = &*I;
+    if (I->getAddr() == 0)
       I->getBinary()->setName(&*I);
-    }
   }
 
   // Associate separate binaries and find the last top-level kernel.
@@ -160,10 +192,9 @@ bool PatchInfoLinker::link(cm::patch::Collection &C) {
     B.clearSyncPoints();
     ++n;
     // Check link type through its symbol.
-    auto M = BinMap.find(&B);
-    if (M == BinMap.end()) // Bail out if there's binary without symbol name.
+    auto S = B.getName();
+    if (!S) // Bail out if there's binary without symbol name.
       return true;
-    auto S = M->second;
     B.setLinkType(S->getExtra() & 0x3);
     if (B.getLinkType() != CM_FC_LINK_TYPE_CALLEE)
     {
@@ -196,30 +227,20 @@ bool PatchInfoLinker::link(cm::patch::Collection &C) {
     // Real binary starts from here.
     Bin->setPos(unsigned(Linked.size()));
     Bin->sortSyncPoints();
+    std::vector<unsigned> SyncSizes;
     unsigned Start = 0;
-    unsigned Inserted = 0;
     for (auto SI = Bin->sp_begin(), SE = Bin->sp_end(); SI != SE; ++SI) {
       auto Node = *SI;
       unsigned Offset = Node->getOffset();
       assert(Start <= Offset && "Invalid insert point!");
-      if (Start < Offset) {
+      if (Start < Offset)
         Linked.append(Bin->getData() + Start, Offset - Start);
-        // Adjust relocation in this range.
-        for (auto RI = Bin->rel_begin(), RE = Bin->rel_end(); RI != RE; ++RI) {
-          unsigned RelOff = RI->getOffset();
-          if (Start <= RelOff && RelOff < Offset)
-            RI->setOffset(RelOff + Inserted);
-        }
-      }
       Start = Offset;
-      Inserted += writeSync(Node->getRdTokenMask(), Node->getWrTokenMask());
+      SyncSizes.push_back(
+          writeSync(Node->getRdTokenMask(), Node->getWrTokenMask()));
     }
     Linked.append(Bin->getData() + Start, Bin->getSize() - Start);
-    for (auto RI = Bin->rel_begin(), RE = Bin->rel_end(); RI != RE; ++RI) {
-      unsigned RelOff = RI->getOffset();
-      if (Start <= RelOff && RelOff < Bin->getSize())
-        RI->setOffset(RelOff + Inserted);
-    }
+    shiftRelocations(*Bin, SyncSizes);
     if (Bin == LastTopBin)
       writeEOT();
   }
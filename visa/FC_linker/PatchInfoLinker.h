@@ -14,10 +14,18 @@ SPDX-License-Identifier: MIT
 #ifndef __CM_FC_PATCHINFO_LINKER_H__
 #define __CM_FC_PATCHINFO_LINKER_H__
 
+#include <vector>
+
 #include "cm_fc_ld.h"
 
 #include "PatchInfoRecord.h"
 
+/// Move the relocations of @p Bin past the sync instructions inserted at its
+/// sync points, which must be sorted. @p SyncSizes has the number of bytes
+/// inserted at each of them, in the same order.
+void shiftRelocations(cm::patch::Binary &Bin,
+                      const std::vector<unsigned> &SyncSizes);
+
 bool linkPatchInfo(cm::patch::Collection &C,
                    std::size_t NumKernels, cm_fc_kernel_t *Kernels,
                    const char *Options);
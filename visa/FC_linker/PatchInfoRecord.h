@@ -23,6 +23,7 @@ SPDX-License-Identifier: MIT
 #include <queue>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "../PatchInfo.h"
 
@@ -441,9 +442,18 @@ public:
   typedef std::list<Binary> BinaryList;
   typedef std::list<Symbol> SymbolList;
 
-  struct cstring_less {
+  struct cstring_hash {
+    std::size_t operator()(const char *s) const {
+      // FNV-1a
+      std::size_t h = std::size_t(14695981039346656037ULL);
+      for (; *s; ++s)
+        h = (h ^ (unsigned char)*s) * std::size_t(1099511628211ULL);
+      return h;
+    }
+  };
+  struct cstring_equal {
     bool operator()(const char *s0, const char *s1) const {
-      return std::strcmp(s0, s1) < 0;
+      return std::strcmp(s0, s1) == 0;
     }
   };
 
@@ -456,7 +466,9 @@ private:
 
   std::list<std::string> NewNames;
 
-  std::map<const char *, Symbol *, cstring_less> SymbolMap;
+  // Symbols of all of the binaries, indexed by name.
+  std::unordered_map<const char *, Symbol *, cstring_hash, cstring_equal>
+      SymbolMap;
 
   std::string Linked;
 
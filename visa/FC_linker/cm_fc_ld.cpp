@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 
 #include "cm_fc_ld.h"
 
+#include "LinkCache.h"
 #include "PatchInfoLinker.h"
 #include "PatchInfoReader.h"
 #include "PatchInfoRecord.h"
@@ -63,11 +64,25 @@ int cm_fc_combine_kernels(size_t num_kernels, cm_fc_kernel_t kernels[],
   if (!out_buf || !out_size)
     return CM_FC_FAILURE;
 
+  cm::patch::LinkCache &Cache = cm::patch::LinkCache::get();
+  cm::patch::LinkCache::Key Key = {0, 0};
+  std::string Cached;
+  bool UseCache = Cache.isEnabled();
+  bool Hit = false;
+  if (UseCache) {
+    Key = cm::patch::LinkCache::getKey(num_kernels, kernels, options);
+    Hit = Cache.lookup(Key, Cached);
+  }
+
   cm::patch::Collection C;
-  if (linkPatchInfo(C, num_kernels, kernels, options))
-    return CM_FC_FAILURE;
+  if (!Hit) {
+    if (linkPatchInfo(C, num_kernels, kernels, options))
+      return CM_FC_FAILURE;
+    if (UseCache)
+      Cache.insert(Key, C.getLinkedBinary());
+  }
 
-  const std::string &B = C.getLinkedBinary();
+  const std::string &B = Hit ? Cached : C.getLinkedBinary();
   if (B.size() > *out_size) {
     *out_size = B.size();
     return CM_FC_NOBUFS;
@@ -78,3 +93,8 @@ int cm_fc_combine_kernels(size_t num_kernels, cm_fc_kernel_t kernels[],
 
   return CM_FC_OK;
 }
+
+int cm_fc_set_link_cache(int enable, const char *cache_dir) {
+  cm::patch::LinkCache::get().setEnabled(enable != 0, cache_dir);
+  return CM_FC_OK;
+}
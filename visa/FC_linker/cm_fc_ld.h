@@ -87,6 +87,22 @@ int cm_fc_combine_kernels(size_t num_kernels, cm_fc_kernel_t *kernels,
                           char *out_buf, size_t *out_size,
                           const char *options);
 
+/**
+ * @brief Enable or disable the cache of combined kernels.
+ *
+ * When enabled, cm_fc_combine_kernels returns the combined binary of the
+ * same kernels and options from the cache instead of linking them again.
+ * The cache is disabled by default.
+ *
+ * @param enable    Non-zero to enable the cache, zero to disable and clear it.
+ * @param cache_dir If not null, the directory where the combined binaries are
+ *                  also kept as files, so that they are reused by later
+ *                  processes. The directory has to exist and must be
+ *                  private to the user: the binaries found in it are
+ *                  returned without being checked against the kernels.
+ */
+int cm_fc_set_link_cache(int enable, const char *cache_dir);
+
 #ifdef __cplusplus
 }
 #endif
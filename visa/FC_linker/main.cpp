@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 #include <cstdio>
 #include <cstring>
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -92,10 +93,11 @@ int getopt(int nargc, char *const nargv[], const char *ostr) {
 #include "PatchInfoRecord.h"
 
 static bool Brief = false;
+static unsigned BenchRuns = 0;
 
 static void usage(FILE *fp, int argc, char *argv[]) {
-  std::fprintf(fp, "usage: %s [-c|-d|-q] [-e <string>] [-o <file>] file...\n\n",
-               argv[0]);
+  std::fprintf(fp, "usage: %s [-c|-d|-q] [-b <n>] [-e <string>] [-o <file>] "
+               "file...\n\n", argv[0]);
   std::fprintf(fp, "CM fast composite offline linker.\n\n");
   std::fprintf(fp, "%-28s%s\n", "  -c", "Combine kernels specified.");
   std::fprintf(fp, "%-28s%s\n", "  -d", "Dump the patch info.");
@@ -103,6 +105,9 @@ static void usage(FILE *fp, int argc, char *argv[]) {
   std::fprintf(fp, "%-28s%s\n", "  -r", "Read the patch info.");
   std::fprintf(fp, "%-28s%s\n", "  -o <file>", "Place the output into <file>.");
   std::fprintf(fp, "%-28s%s\n", "  -e <string>", "Extra link options.");
+  std::fprintf(fp, "%-28s%s\n", "  -b <n>",
+               "Combine the kernels <n> times, with and without the link "
+               "cache, and report the link latency.");
   std::fprintf(fp, "\n");
 }
 
@@ -196,6 +201,46 @@ static void query_args(int argc, char *argv[], const char *Out) {
     fclose(fp);
 }
 
+/// Measure the latency of cm_fc_combine_kernels on the given kernels, first
+/// linking them every time and then with the link cache.
+static void benchmark(std::vector<cm_fc_kernel_t> &Kernels,
+                      const char *ExtraOpts) {
+  std::vector<char> Out(1);
+  auto run = [&](unsigned N) {
+    auto Start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != N; ++i) {
+      std::size_t Size = Out.size();
+      int Ret = cm_fc_combine_kernels(Kernels.size(), Kernels.data(),
+                                      Out.data(), &Size, ExtraOpts);
+      if (Ret == CM_FC_NOBUFS) {
+        Out.resize(Size);
+        Ret = cm_fc_combine_kernels(Kernels.size(), Kernels.data(),
+                                    Out.data(), &Size, ExtraOpts);
+      }
+      if (Ret != CM_FC_OK) {
+        std::cerr << "Failed to combine kernels.\n";
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    std::chrono::duration<double, std::micro> T =
+        std::chrono::steady_clock::now() - Start;
+    return T.count() / N;
+  };
+
+  cm_fc_set_link_cache(0, nullptr);
+  double Uncached = run(BenchRuns);
+  cm_fc_set_link_cache(1, nullptr);
+  double First = run(1);
+  double Cached = run(BenchRuns);
+  cm_fc_set_link_cache(0, nullptr);
+
+  std::fprintf(stderr, "%u kernel(s), %u run(s)\n", unsigned(Kernels.size()),
+               BenchRuns);
+  std::fprintf(stderr, "%-28s%10.2f us\n", "  link (no cache):", Uncached);
+  std::fprintf(stderr, "%-28s%10.2f us\n", "  link (cache miss):", First);
+  std::fprintf(stderr, "%-28s%10.2f us\n", "  link (cache hit):", Cached);
+}
+
 static void combine(const std::vector<std::string> &Bufs,
                     char *argv[], FILE *fp, const char *ExtraOpts) {
   std::vector<cm_fc_kernel_t> Kernels;
@@ -210,6 +255,9 @@ static void combine(const std::vector<std::string> &Bufs,
     Kernels.push_back(K);
   }
 
+  if (BenchRuns)
+    benchmark(Kernels, ExtraOpts);
+
   if (linkPatchInfo(C, Kernels.size(), Kernels.data(), ExtraOpts)) {
     std::cerr << "Failed to combine kernels.\n";
     return;
@@ -321,7 +369,7 @@ int main(int argc, char *argv[]) {
   char Action = '\0';
 
   int Opt;
-  while ((Opt = getopt(argc, argv, "cdqrBDe:o:")) != -1) {
+  while ((Opt = getopt(argc, argv, "cdqrBDb:e:o:")) != -1) {
     switch (Opt) {
     case 'c':
     case 'd':
@@ -340,6 +388,9 @@ int main(int argc, char *argv[]) {
     case 'e':
       ExtraOptions = optarg;
       break;
+    case 'b':
+      BenchRuns = unsigned(std::strtoul(optarg, nullptr, 10));
+      break;
     default:
       usage(stdout, argc, argv);
       std::exit(EXIT_FAILURE);
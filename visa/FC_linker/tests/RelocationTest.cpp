@@ -0,0 +1,92 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Checks that relocations are moved past the inserted sync instructions.
+//
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <string>
+#include <vector>
+
+#include "PatchInfoLinker.h"
+#include "PatchInfoRecord.h"
+
+namespace {
+
+unsigned Failures = 0;
+
+void expectOffset(const cm::patch::Relocation *R, unsigned Expected,
+                  const char *What) {
+  if (R->getOffset() == Expected)
+    return;
+  std::fprintf(stderr, "%s: relocation at %u, expected %u\n", What,
+               R->getOffset(), Expected);
+  ++Failures;
+}
+
+// Instructions are 16 bytes. Sync points are at 16 and 48, and each one
+// inserts a 16-byte sync instruction.
+void testShiftOncePerSyncPoint() {
+  std::string Data(64, '\0');
+  cm::patch::Binary Bin(Data.data(), Data.size());
+  cm::patch::Symbol S("callee", 0, &Bin, 0);
+  cm::patch::DepNode N0(&Bin, 16, false), N1(&Bin, 48, false);
+  Bin.insertSyncPoint(&N1);
+  Bin.insertSyncPoint(&N0);
+  Bin.sortSyncPoints();
+
+  // Added out of order, as the walk sorts them.
+  auto R32 = Bin.addReloc(32, &S);
+  auto R0 = Bin.addReloc(0, &S);
+  auto R48 = Bin.addReloc(48, &S);
+  auto R16 = Bin.addReloc(16, &S);
+
+  shiftRelocations(Bin, {16, 16});
+
+  expectOffset(R0, 0, "before the first sync point");
+  expectOffset(R16, 32, "at the first sync point");
+  // Once moved by the first sync instruction, this one is at 48, which is
+  // past the second sync point. It must not be moved a second time.
+  expectOffset(R32, 48, "between the sync points");
+  expectOffset(R48, 80, "at the second sync point");
+}
+
+// Sync points at the same offset add up, and a binary without relocations or
+// sync points is left alone.
+void testSameOffsetAndEmpty() {
+  std::string Data(32, '\0');
+  cm::patch::Binary Bin(Data.data(), Data.size());
+  cm::patch::Symbol S("callee", 0, &Bin, 0);
+  cm::patch::DepNode N0(&Bin, 16, false), N1(&Bin, 16, false);
+  Bin.insertSyncPoint(&N0);
+  Bin.insertSyncPoint(&N1);
+  Bin.sortSyncPoints();
+  auto R16 = Bin.addReloc(16, &S);
+  shiftRelocations(Bin, {16, 32});
+  expectOffset(R16, 64, "after two sync points at the same offset");
+
+  cm::patch::Binary Empty(Data.data(), Data.size());
+  shiftRelocations(Empty, {});
+  auto R0 = Empty.addReloc(0, &S);
+  shiftRelocations(Empty, {});
+  expectOffset(R0, 0, "without sync points");
+}
+
+} // End anonymous namespace
+
+int main() {
+  testShiftOncePerSyncPoint();
+  testSameOffsetAndEmpty();
+  if (Failures) {
+    std::fprintf(stderr, "%u failure(s)\n", Failures);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
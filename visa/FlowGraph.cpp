@@ -316,7 +316,7 @@ void FlowGraph::removePredSuccEdges(G4_BB* pred, G4_BB* succ)
 {
     MUST_BE_TRUE(pred != NULL && succ != NULL, ERROR_INTERNAL_ARGUMENT);
 
-    BB_LIST_ITER lt = pred->Succs.begin();
+    BB_EDGE_LIST_ITER lt = pred->Succs.begin();
     for (; lt != pred->Succs.end(); ++lt) {
         if ((*lt) == succ) {
             pred->Succs.erase(lt);
@@ -1467,8 +1467,8 @@ G4_BB* FlowGraph::mergeSubRoutineReturn(G4_Label* subroutineLabel)
         G4_BB* candidateBB = *(retBBList.rbegin());
         // Add <newBB, succBB> edges
         G4_INST* last = candidateBB->back();
-        BB_LIST_ITER succIt = (last->getPredicate() == NULL) ? candidateBB->Succs.begin() : (++candidateBB->Succs.begin());
-        BB_LIST_ITER succItEnd = candidateBB->Succs.end();
+        BB_EDGE_LIST_ITER succIt = (last->getPredicate() == NULL) ? candidateBB->Succs.begin() : (++candidateBB->Succs.begin());
+        BB_EDGE_LIST_ITER succItEnd = candidateBB->Succs.end();
         // link new ret BB with each call site
         for (; succIt != succItEnd; ++succIt) {
             addPredSuccEdges(newBB, (*succIt), false);
@@ -1521,7 +1521,7 @@ void FlowGraph::decoupleInitBlock(G4_BB* bb, FuncInfoHashTable& funcInfoHashTabl
     MUST_BE_TRUE(insertBefore != BBs.end(), ERROR_FLOWGRAPH);
     insert(insertBefore, newInitBB);
 
-    BB_LIST_ITER kt = oldInitBB->Preds.begin();
+    BB_EDGE_LIST_ITER kt = oldInitBB->Preds.begin();
     while (kt != oldInitBB->Preds.end())
     {
         // the pred of this new INIT BB are all call BB
@@ -1529,7 +1529,7 @@ void FlowGraph::decoupleInitBlock(G4_BB* bb, FuncInfoHashTable& funcInfoHashTabl
 
             newInitBB->Preds.push_back((*kt));
 
-            BB_LIST_ITER jt = (*kt)->Succs.begin();
+            BB_EDGE_LIST_ITER jt = (*kt)->Succs.begin();
             while (jt != (*kt)->Succs.end()) {
                 if ((*jt) == oldInitBB)
                 {
@@ -1538,13 +1538,10 @@ void FlowGraph::decoupleInitBlock(G4_BB* bb, FuncInfoHashTable& funcInfoHashTabl
                 jt++;
             }
             MUST_BE_TRUE(jt != (*kt)->Succs.end(), ERROR_FLOWGRAPH);
-            (*kt)->Succs.insert(jt, newInitBB);
-            (*kt)->Succs.erase(jt);
+            *jt = newInitBB;
 
-            BB_LIST_ITER tmp_kt = kt;
-            ++kt;
             // erase this pred from old INIT BB's pred
-            oldInitBB->Preds.erase(tmp_kt);
+            kt = oldInitBB->Preds.erase(kt);
         }
         else
         {
@@ -1585,7 +1582,8 @@ void FlowGraph::decoupleReturnBlock(G4_BB* bb)
     newRetBB->Succs.push_back(oldRetBB);
 
     std::replace(oldRetBB->Preds.begin(), oldRetBB->Preds.end(), itsExitBB, newRetBB);
-    oldRetBB->Preds.unique();
+    oldRetBB->Preds.erase(
+        std::unique(oldRetBB->Preds.begin(), oldRetBB->Preds.end()), oldRetBB->Preds.end());
 
     oldRetBB->unsetBBType(G4_BB_RETURN_TYPE);
     newRetBB->setBBType(G4_BB_RETURN_TYPE);
@@ -2023,8 +2021,7 @@ void FlowGraph::removeRedundantLabels()
                     }
                 }
 
-                pred->Succs.insert(jt, bb->Succs.front());
-                pred->Succs.erase(jt);
+                *jt = bb->Succs.front();
 
                 // [Bug1915]: In rare case the precessor may have more than one Succ edge pointing
                 // to the same BB, due to empty block being eliminated.  For example, with
@@ -2040,36 +2037,17 @@ void FlowGraph::removeRedundantLabels()
                 // edge to a non-existing BB.  Note that we don't just delete the edge because
                 // elsewhere there may be assumptions that if a BB ends with a jump it must have
                 // two successors
-                {
-                    BB_LIST_ITER succs = pred->Succs.begin();
-                    BB_LIST_ITER end = pred->Succs.end();
-                    while (succs != end)
-                    {
-                        BB_LIST_ITER iter = succs;
-                        ++succs;
-                        if ((*iter) == bb)
-                        {
-                            pred->Succs.insert(iter, bb->Succs.front());
-                            pred->Succs.erase(iter);
-                        }
-                    }
-                }
+                std::replace(pred->Succs.begin(), pred->Succs.end(), bb, bb->Succs.front());
             }
 
             //
             // Replace the unique successor's predecessor links with the removed block's predessors.
             //
-            BB_LIST_ITER kt = std::find(bb->Succs.front()->Preds.begin(), bb->Succs.front()->Preds.end(), bb);
-
-            BB_LIST_ITER mt = bb->Preds.begin();
-
-            for (; mt != bb->Preds.end(); ++mt)
-            {
-                bb->Succs.front()->Preds.insert(kt, *mt);
-            }
-
-            bb->Succs.front()->Preds.erase(kt);
-            bb->Succs.front()->Preds.unique();
+            G4_BB* succ = bb->Succs.front();
+            BB_EDGE_LIST_ITER kt = std::find(succ->Preds.begin(), succ->Preds.end(), bb);
+            kt = succ->Preds.erase(kt);
+            succ->Preds.insert(kt, bb->Preds.begin(), bb->Preds.end());
+            succ->Preds.erase(std::unique(succ->Preds.begin(), succ->Preds.end()), succ->Preds.end());
             //
             // Propagate the removed block's type to its unique successor.
             //
@@ -2246,14 +2224,11 @@ void FlowGraph::removeEmptyBlocks()
                     //
                     // Replace the predecessors successor links to the removed block's unique successor.
                     //
-                    BB_LIST_ITER jt = std::find(predBB->Succs.begin(), predBB->Succs.end(), bb);
-
-                    for (auto succBB : bb->Succs)
-                    {
-                        predBB->Succs.insert(jt, succBB);
-                    }
-                    predBB->Succs.erase(jt);
-                    predBB->Succs.unique();
+                    BB_EDGE_LIST_ITER jt = std::find(predBB->Succs.begin(), predBB->Succs.end(), bb);
+                    jt = predBB->Succs.erase(jt);
+                    predBB->Succs.insert(jt, bb->Succs.begin(), bb->Succs.end());
+                    predBB->Succs.erase(
+                        std::unique(predBB->Succs.begin(), predBB->Succs.end()), predBB->Succs.end());
                 }
 
                 for (auto succBB : bb->Succs)
@@ -2261,15 +2236,11 @@ void FlowGraph::removeEmptyBlocks()
                     //
                     // Replace the unique successor's predecessor links with the removed block's predessors.
                     //
-                    BB_LIST_ITER kt = std::find(succBB->Preds.begin(), succBB->Preds.end(), bb);
-
-                    for (auto predBB : bb->Preds)
-                    {
-                        succBB->Preds.insert(kt, predBB);
-                    }
-
-                    succBB->Preds.erase(kt);
-                    succBB->Preds.unique();
+                    BB_EDGE_LIST_ITER kt = std::find(succBB->Preds.begin(), succBB->Preds.end(), bb);
+                    kt = succBB->Preds.erase(kt);
+                    succBB->Preds.insert(kt, bb->Preds.begin(), bb->Preds.end());
+                    succBB->Preds.erase(
+                        std::unique(succBB->Preds.begin(), succBB->Preds.end()), succBB->Preds.end());
 
                     //
                     // Propagate the removed block's type to its unique successor.
@@ -3352,7 +3323,7 @@ void FlowGraph::processGoto(bool HasSIMDCF)
         // check to see if this block is the target of one (or more) backward goto
         // If so, we process the backward goto and push its fall-thru block to the
         // active join list
-        for (std::list<G4_BB*>::iterator iter = bb->Preds.begin(), iterEnd = bb->Preds.end(); iter != iterEnd; ++iter)
+        for (BB_EDGE_LIST_ITER iter = bb->Preds.begin(), iterEnd = bb->Preds.end(); iter != iterEnd; ++iter)
         {
             G4_BB* predBB = *iter;
             G4_INST* lastInst = predBB->back();
@@ -4043,8 +4014,8 @@ void FlowGraph::DFSTraverse(G4_BB* startBB, unsigned &preId, unsigned &postId, F
         else
         {
             // To be consistent with previous behavior, use reverse_iter.
-            BB_LIST_RITER RIE = bb->Succs.rend();
-            for (BB_LIST_RITER rit = bb->Succs.rbegin(); rit != RIE; ++rit)
+            BB_EDGE_LIST_RITER RIE = bb->Succs.rend();
+            for (BB_EDGE_LIST_RITER rit = bb->Succs.rbegin(); rit != RIE; ++rit)
             {
                 G4_BB* succBB = *rit;
                 if (succBB->getPreId() == UINT_MAX)
@@ -4072,6 +4043,7 @@ void vISA::FlowGraph::markStale()
     immDom.setStale();
     pDom.setStale();
     loops.setStale();
+    order.setStale();
 
     // any other analysis that becomes stale when FlowGraph changes
     // should be marked as stale here.
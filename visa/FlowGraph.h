@@ -219,6 +219,7 @@ class FlowGraph
     vISA::ImmDominator immDom;
     vISA::PostDom pDom;
     vISA::LoopDetection loops;
+    vISA::CFGOrder order;
 
 public:
     typedef std::pair<G4_BB*, G4_BB*> Edge;
@@ -449,7 +450,7 @@ public:
       pKernel(kernel), mem(m), instListAlloc(alloc),
       kernelInfo(NULL), builder(NULL), globalOpndHT(m), framePtrDcl(NULL),
       stackPtrDcl(NULL), scratchRegDcl(NULL), pseudoVCEDcl(NULL),
-      dom(*kernel), immDom(*kernel), pDom(*kernel), loops(*kernel) {}
+      dom(*kernel), immDom(*kernel), pDom(*kernel), loops(*kernel), order(*kernel) {}
 
     ~FlowGraph();
 
@@ -460,11 +461,11 @@ public:
         markStale();
 
         if (tofront)
-            pred->Succs.push_front(succ);
+            pred->Succs.insert(pred->Succs.begin(), succ);
         else
             pred->Succs.push_back(succ);
 
-        succ->Preds.push_front(pred);
+        succ->Preds.insert(succ->Preds.begin(), pred);
     }
 
     void addUniquePredSuccEdges(G4_BB* pred, G4_BB* succ, bool tofront=true)
@@ -641,6 +642,7 @@ public:
     ImmDominator& getImmDominator() { return immDom; }
     PostDom& getPostDominator() { return pDom; }
     LoopDetection& getLoops() { return loops; }
+    CFGOrder& getCFGOrder() { return order; }
     void markStale();
 
 private:
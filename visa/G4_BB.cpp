@@ -76,7 +76,7 @@ void G4_BB::setId(unsigned i)
 
 void G4_BB::removePredEdge(G4_BB* pred)
 {
-    for (std::list<G4_BB*>::iterator it = Preds.begin(), bbEnd = Preds.end();
+    for (BB_EDGE_LIST_ITER it = Preds.begin(), bbEnd = Preds.end();
         it != bbEnd; ++it)
     {
         if (*it != pred) continue;
@@ -90,7 +90,7 @@ void G4_BB::removePredEdge(G4_BB* pred)
 
 void G4_BB::removeSuccEdge(G4_BB* succ)
 {
-    for (std::list<G4_BB*>::iterator it = Succs.begin(), bbEnd = Succs.end(); it != bbEnd; ++it)
+    for (BB_EDGE_LIST_ITER it = Succs.begin(), bbEnd = Succs.end(); it != bbEnd; ++it)
     {
         if (*it != succ) continue;
         // found
@@ -1500,7 +1500,7 @@ void G4_BB::emitBbInfo(std::ostream& os) const {
         maybeComma();
         os << " [inDivergent]";
     }
-    auto emitBbSet = [&](const char *name, const BB_LIST &bbl) {
+    auto emitBbSet = [&](const char *name, const BB_EDGE_LIST &bbl) {
         maybeComma();
         os << " " << name << ":{";
         bool first = true;
@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 namespace vISA
 {
@@ -23,6 +24,14 @@ typedef BB_LIST::iterator                 BB_LIST_ITER;
 typedef BB_LIST::const_iterator           BB_LIST_CITER;
 typedef BB_LIST::reverse_iterator         BB_LIST_RITER;
 
+// Predecessors and successors of a BB. A block rarely has more than a couple
+// of either, so they are kept in a contiguous array that the dataflow
+// solvers walk without chasing list nodes.
+typedef std::vector<G4_BB*>               BB_EDGE_LIST;
+typedef BB_EDGE_LIST::iterator            BB_EDGE_LIST_ITER;
+typedef BB_EDGE_LIST::const_iterator      BB_EDGE_LIST_CITER;
+typedef BB_EDGE_LIST::reverse_iterator    BB_EDGE_LIST_RITER;
+
 //
 // Block types
 //
@@ -195,8 +204,8 @@ public:
     // If we don't maintain this property, extra checking (e.g., label
     // comparison) is needed to retrieve fallThroughBB
     //
-    BB_LIST    Preds;
-    BB_LIST    Succs;
+    BB_EDGE_LIST Preds;
+    BB_EDGE_LIST Succs;
 
     G4_BB(INST_LIST_NODE_ALLOCATOR& alloc, unsigned i, FlowGraph* fg) :
         id(i), preId(0), rpostId(0),
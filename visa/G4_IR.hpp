@@ -125,6 +125,118 @@ namespace vISA
 
         bool operator!=(const std_arena_based_allocator & a) const { return !operator==(a); }
     };
+
+    // Node pool for the def-use chains of G4_INST.
+    // The chains of every instruction are cleared and rebuilt each time the
+    // local dataflow is recomputed. The freed nodes are kept on a free list
+    // and reused, so rebuilding the chains does not grow the arena.
+    class UseDefNodePool
+    {
+        struct FreeNode { FreeNode* next; };
+        // one free list per node size, in practice only the list node of
+        // USE_DEF_NODE is ever allocated
+        struct FreeList
+        {
+            std::size_t size = 0;
+            FreeNode* head = nullptr;
+        };
+
+        Mem_Manager mem;
+        std::array<FreeList, 2> freeLists;
+        std::size_t arenaBytes = 0;
+
+        FreeList* getFreeList(std::size_t size)
+        {
+            for (auto& FL : freeLists)
+            {
+                if (FL.size == size)
+                    return &FL;
+                if (FL.size == 0)
+                {
+                    FL.size = size;
+                    return &FL;
+                }
+            }
+            return nullptr;
+        }
+
+    public:
+        UseDefNodePool() : mem(4096) {}
+        UseDefNodePool(const UseDefNodePool&) = delete;
+        UseDefNodePool& operator=(const UseDefNodePool&) = delete;
+
+        void* alloc(std::size_t size)
+        {
+            FreeList* FL = getFreeList(size);
+            if (FL && FL->head)
+            {
+                FreeNode* node = FL->head;
+                FL->head = node->next;
+                return node;
+            }
+            arenaBytes += size;
+            return mem.alloc(size < sizeof(FreeNode) ? sizeof(FreeNode) : size);
+        }
+
+        void free(void* p, std::size_t size)
+        {
+            FreeList* FL = getFreeList(size);
+            if (!p || !FL)
+                return;
+            FreeNode* node = static_cast<FreeNode*>(p);
+            node->next = FL->head;
+            FL->head = node;
+        }
+
+        // bytes taken from the arena so far, i.e., the peak size of the chains
+        std::size_t getArenaBytes() const { return arenaBytes; }
+    };
+
+    // Allocator of the def-use chains. Unlike std_arena_based_allocator it
+    // is a plain pointer to the pool owned by IR_Builder, which keeps the
+    // two chains of every instruction small and avoids the reference
+    // counting on every instruction construction.
+    template <class T>
+    class use_def_allocator
+    {
+        UseDefNodePool* pool;
+
+    public:
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T*             pointer;
+        typedef const T*       const_pointer;
+        typedef T&             reference;
+        typedef const T&       const_reference;
+        typedef T              value_type;
+
+        explicit use_def_allocator(UseDefNodePool* p) : pool(p) {}
+
+        template <class U>
+        use_def_allocator(const use_def_allocator<U>& other) : pool(other.pool) {}
+
+        template <class U>
+        struct rebind { typedef use_def_allocator<U> other; };
+
+        template <class U> friend class use_def_allocator;
+
+        pointer allocate(size_type n, const void * = 0)
+        {
+            return (T*)pool->alloc(n * sizeof(T));
+        }
+
+        void deallocate(void* p, size_type n)
+        {
+            pool->free(p, n * sizeof(T));
+        }
+
+        size_type max_size() const { return size_t(-1); }
+
+        template <class U>
+        bool operator==(const use_def_allocator<U>& a) const { return pool == a.pool; }
+        template <class U>
+        bool operator!=(const use_def_allocator<U>& a) const { return pool != a.pool; }
+    };
 }
 
 // We use memory manager.  Memory manager will free all the space at once so that
@@ -238,7 +350,7 @@ typedef std::list<vISA::G4_INST*, INST_LIST_NODE_ALLOCATOR>::const_iterator INST
 typedef std::list<vISA::G4_INST*, INST_LIST_NODE_ALLOCATOR>::reverse_iterator INST_LIST_RITER;
 
 typedef std::pair<vISA::G4_INST*, Gen4_Operand_Number> USE_DEF_NODE;
-typedef vISA::std_arena_based_allocator<USE_DEF_NODE> USE_DEF_ALLOCATOR;
+typedef vISA::use_def_allocator<USE_DEF_NODE> USE_DEF_ALLOCATOR;
 
 typedef std::list<USE_DEF_NODE, USE_DEF_ALLOCATOR > USE_EDGE_LIST;
 typedef std::list<USE_DEF_NODE, USE_DEF_ALLOCATOR >::iterator USE_EDGE_LIST_ITER;
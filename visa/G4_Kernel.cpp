@@ -1176,7 +1176,7 @@ void G4_Kernel::dumpDotFileInternal(const std::string &baseName)
         // dump out succ edges
         // BB12 -> BB10
         //
-        for (std::list<G4_BB*>::iterator sit = bb->Succs.begin();
+        for (BB_EDGE_LIST_ITER sit = bb->Succs.begin();
             sit != bb->Succs.end(); ++sit)
         {
             bb->writeBBId(ofile);
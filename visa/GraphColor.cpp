@@ -27,6 +27,7 @@ SPDX-License-Identifier: MIT
 #include <list>
 #include <sstream>
 #include "SplitAlignedScalars.h"
+#include "LoopSplit.h"
 
 using namespace vISA;
 
@@ -9906,6 +9907,10 @@ int GlobalRA::coloringRegAlloc()
 
     uint32_t GRFSpillFillCount = 0;
     uint32_t sendAssociatedGRFSpillFillCount = 0;
+    // references to spilled variables weighted by loop nesting, summed over
+    // all spill iterations, before and after loop-aware spill placement
+    uint64_t weightedSpilledRefs = 0;
+    uint64_t weightedSpilledRefsAfterPlacement = 0;
     unsigned fastCompileIter = 1;
     bool fastCompile =
         (builder.getOption(vISA_FastCompileRA) || builder.getOption(vISA_HybridRAWithSpill)) &&
@@ -9917,7 +9922,7 @@ int GlobalRA::coloringRegAlloc()
     }
 
     unsigned failSafeRAIteration = (builder.getOption(vISA_FastSpill) || fastCompile) ? fastCompileIter : FAIL_SAFE_RA_LIMIT;
-    bool rematDone = false, alignedScalarSplitDone = false;
+    bool rematDone = false, alignedScalarSplitDone = false, loopSplitDone = false;
     VarSplit splitPass(*this);
     while (iterationNo < maxRAIterations)
     {
@@ -10072,6 +10077,43 @@ int GlobalRA::coloringRegAlloc()
                     rerunGRA |= split.getChangesMade();
                 }
 
+                // Split spill candidates at the boundaries of the loops that
+                // reference them and retry coloring before spilling. Wait
+                // until the passes above leave the IR unchanged so that
+                // liveness and pressure are up to date.
+                if (kernel.getOption(vISA_LoopSplit) &&
+                    !fastCompile &&
+                    !kernel.getOption(vISA_FastSpill) &&
+                    iterationNo == 0 &&
+                    !rerunGRA &&
+                    !loopSplitDone)
+                {
+                    std::vector<const LiveRange*> candidates;
+                    for (auto lr : coloring.getSpilledLiveRanges())
+                    {
+                        if (lr->getRegKind() == G4_GRF &&
+                            !lr->getVar()->isRegVarTransient() &&
+                            !lr->getVar()->isRegVarTmp() &&
+                            LoopSplit::isCandidate(*this, lr))
+                        {
+                            candidates.push_back(lr);
+                        }
+                    }
+
+                    LoopSplit split(*this, liveAnalysis, rpe);
+                    split.run(candidates, true);
+                    loopSplitDone = true;
+
+                    if (builder.getOption(vISA_RATrace))
+                    {
+                        std::cout << "\t--split live ranges at loop boundaries\n";
+                        split.dump(std::cout);
+                    }
+
+                    // Re-run GRA loop if changes were made to IR
+                    rerunGRA |= split.getChangesMade();
+                }
+
                 //Calculate the spill caused by send to decide if global splitting is required or not
                 for (auto spilled : coloring.getSpilledLiveRanges())
                 {
@@ -10189,10 +10231,13 @@ int GlobalRA::coloringRegAlloc()
                     indrSpillRegSize,
                     enableSpillSpaceCompression,
                     useScratchMsgForSpill,
-                    builder.avoidDstSrcOverlap());
+                    builder.avoidDstSrcOverlap(),
+                    &rpe);
 
                 bool success = spillGRF.insertSpillFillCode(&kernel, pointsToAnalysis);
                 nextSpillOffset = spillGRF.getNextOffset();
+                weightedSpilledRefs += spillGRF.getWeightedSpilledRefs();
+                weightedSpilledRefsAfterPlacement += spillGRF.getWeightedSpilledRefsAfterPlacement();
 
                 if (builder.hasFusedEUWA() && !euWADone)
                 {
@@ -10229,6 +10274,12 @@ int GlobalRA::coloringRegAlloc()
                         std::cout << "\n";
                     }
                     std::cout << "\t--current spill size: " << nextSpillOffset << "\n";
+                    std::cout << "\t--weighted refs to spilled variables: " << spillGRF.getWeightedSpilledRefs();
+                    if (builder.getOption(vISA_SpillLoopPlacement))
+                    {
+                        std::cout << " (" << spillGRF.getWeightedSpilledRefsAfterPlacement() << " after loop placement)";
+                    }
+                    std::cout << "\n";
                 }
 
                 if (!success)
@@ -10330,6 +10381,21 @@ int GlobalRA::coloringRegAlloc()
     assignRegForAliasDcl();
     computePhyReg();
 
+    if (builder.getOption(vISA_OptReport) && weightedSpilledRefs > 0)
+    {
+        std::ofstream optreport;
+        getOptReportStream(optreport, builder.getOptions());
+        // Counted as the spill code is planned, before spill cleanup and the
+        // next RA iterations.
+        optreport << "Weighted references to spilled GRF variables: " << weightedSpilledRefs;
+        if (builder.getOption(vISA_SpillLoopPlacement))
+        {
+            optreport << ", " << weightedSpilledRefsAfterPlacement << " after loop placement";
+        }
+        optreport << std::endl;
+        closeOptReportStream(optreport);
+    }
+
     stopTimer(TimerID::GRF_GLOBAL_RA);
     //
     // Report failure to allocate due to excessive register pressure.
@@ -739,6 +739,9 @@ namespace vISA
 
         // store instructions that shouldnt be rematerialized.
         std::unordered_set<G4_INST*> dontRemat;
+        // temps created by splitting live ranges at loop boundaries. They
+        // already cover a single loop, so they are never split again.
+        std::unordered_set<const G4_Declare*> loopSplitTmps;
 
         RAVarInfo &allocVar(const G4_Declare* dcl)
         {
@@ -1257,6 +1260,16 @@ namespace vISA
         {
             dontRemat.insert(inst);
         }
+
+        bool isLoopSplitTmp(const G4_Declare* dcl) const
+        {
+            return loopSplitTmps.find(dcl) != loopSplitTmps.end();
+        }
+
+        void addLoopSplitTmp(const G4_Declare* dcl)
+        {
+            loopSplitTmps.insert(dcl);
+        }
     };
 
     inline G4_Declare* Interference::getGRFDclForHRA(int GRFNum) const
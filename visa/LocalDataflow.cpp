@@ -10,6 +10,7 @@ SPDX-License-Identifier: MIT
 #include "BitSet.h"
 #include "BuildIR.h"
 #include "LocalDataflow.h"
+#include "Timer.h"
 #include <algorithm>
 #include <unordered_map>
 #include <vector>
@@ -479,6 +480,8 @@ static void processWriteOpnds(G4_BB *BB, G4_INST *Inst, LocalLivenessInfo &LLI)
 
 void FlowGraph::localDataFlowAnalysis()
 {
+    TIME_SCOPE(LOCAL_DATAFLOW);
+
     for (auto BB : BBs) {
         LocalLivenessInfo LLI(!BB->isAllLaneActive());
         for (auto I = BB->rbegin(), E = BB->rend(); I != E; ++I) {
@@ -523,11 +526,17 @@ void FlowGraph::localDataFlowAnalysis()
             }
         }
     }
+
+    builder->getcompilerStats().SetI64(CompilerStats::defUseBytesStr(),
+        builder->getUseDefBytes(), builder->kernel.getSimdSize());
 }
 
-// Reset existing def-use
+// Reset existing def-use. The nodes of the chains go back to the builder's
+// pool and are reused by the next localDataFlowAnalysis.
 void FlowGraph::resetLocalDataFlowData()
 {
+    TIME_SCOPE(LOCAL_DATAFLOW);
+
     globalOpndHT.clearHashTable();
     for (auto bb : BBs)
     {
@@ -5908,12 +5908,12 @@ void SWSB::dumpTokenLiveInfo()
         G4_BB* bb = BBVector[i]->getBB();
 
         std::cerr << "\nBB" << bb->getId() << ":" << BBVector[i]->first_node << "-" << BBVector[i]->last_node << ", succ<";
-        for (std::list<G4_BB*>::iterator sit = bb->Succs.begin(); sit != bb->Succs.end(); ++sit)
+        for (BB_EDGE_LIST_ITER sit = bb->Succs.begin(); sit != bb->Succs.end(); ++sit)
         {
             std::cerr << (*sit)->getId() << ",";
         }
         std::cerr << "> pred<";
-        for (std::list<G4_BB*>::iterator pit = bb->Preds.begin(); pit != bb->Preds.end(); ++pit)
+        for (BB_EDGE_LIST_ITER pit = bb->Preds.begin(); pit != bb->Preds.end(); ++pit)
         {
             std::cerr << (*pit)->getId() << ",";
         }
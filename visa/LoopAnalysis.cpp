@@ -1181,4 +1181,105 @@ void VarReferences::dump(std::ostream& os)
         os << "Data is stale.\n";
 
     os << "#Dcls with defs/uses: " << VarRefs.size();
-}
\ No newline at end of file
+}
+void CFGOrder::reset()
+{
+    rpo.clear();
+    bbs.clear();
+
+    setStale();
+}
+
+void CFGOrder::run()
+{
+    computeRPO();
+
+    setValid();
+}
+
+// BBs are usually added and removed through FlowGraph, which marks this
+// analysis stale, but a few passes still edit the BB list directly and may
+// swap one BB for another without changing the count. Re-run when the BB list
+// differs from the one the order was computed for.
+void CFGOrder::recompute()
+{
+    recomputeIfStale();
+
+    if (!std::equal(bbs.begin(), bbs.end(), kernel.fg.begin(), kernel.fg.end()))
+    {
+        setStale();
+        recomputeIfStale();
+    }
+}
+
+void CFGOrder::computeRPO()
+{
+    FlowGraph& fg = kernel.fg;
+
+    unsigned maxId = 0;
+    for (auto bb : fg)
+    {
+        maxId = std::max(maxId, bb->getId());
+    }
+
+    // iterative DFS, post-order is collected into rpo and reversed at the end
+    std::vector<bool> visited(maxId + 1, false);
+    std::vector<std::pair<G4_BB*, BB_EDGE_LIST_ITER>> stack;
+    auto visit = [&](G4_BB* root)
+    {
+        if (visited[root->getId()])
+            return;
+        visited[root->getId()] = true;
+        stack.push_back(std::make_pair(root, root->Succs.begin()));
+        while (!stack.empty())
+        {
+            G4_BB* bb = stack.back().first;
+            BB_EDGE_LIST_ITER& it = stack.back().second;
+            if (it != bb->Succs.end())
+            {
+                G4_BB* succ = *it;
+                ++it;
+                if (succ->getId() <= maxId && !visited[succ->getId()])
+                {
+                    visited[succ->getId()] = true;
+                    stack.push_back(std::make_pair(succ, succ->Succs.begin()));
+                }
+                continue;
+            }
+            rpo.push_back(bb);
+            stack.pop_back();
+        }
+    };
+
+    if (fg.getEntryBB())
+    {
+        visit(fg.getEntryBB());
+    }
+    for (auto bb : fg)
+    {
+        visit(bb);
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+    bbs.assign(fg.begin(), fg.end());
+}
+
+const std::vector<G4_BB*>& CFGOrder::getRPO()
+{
+    recompute();
+
+    return rpo;
+}
+
+void CFGOrder::dump(std::ostream& os)
+{
+    if (isStale())
+        os << "CFG order is stale.\n";
+
+    os << "RPO:";
+    for (auto bb : rpo)
+    {
+        os << " BB" << bb->getId();
+    }
+    os << "\n";
+}
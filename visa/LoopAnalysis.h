@@ -225,5 +225,31 @@ namespace vISA
         void computeLoopTree();
         void addLoop(Loop* newLoop, Loop* aParent);
     };
+
+    // Reverse post-order of the CFG, shared by the iterative dataflow
+    // solvers. All BBs are numbered: the ones not reachable from the entry
+    // are visited after it, in layout order.
+    class CFGOrder : public Analysis
+    {
+    public:
+        CFGOrder(G4_Kernel& k) : kernel(k)
+        {
+        }
+
+        const std::vector<G4_BB*>& getRPO();
+
+    private:
+        G4_Kernel& kernel;
+        std::vector<G4_BB*> rpo;
+        // BB list in layout order when rpo was computed
+        std::vector<G4_BB*> bbs;
+
+        void recompute();
+        void computeRPO();
+
+        void reset() override;
+        void run() override;
+        void dump(std::ostream& os = std::cerr) override;
+    };
 }
 
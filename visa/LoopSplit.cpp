@@ -0,0 +1,365 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "LoopSplit.h"
+#include "G4_Opcode.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace vISA;
+
+bool LoopSplit::isCandidate(const GlobalRA& gra, const LiveRange* lr)
+{
+    const G4_Declare* dcl = lr->getDcl();
+
+    if (dcl->getRegFile() != G4_GRF ||
+        dcl->getAliasDeclare() ||
+        dcl->getAddressed() ||
+        dcl->getIsPartialDcl() ||
+        dcl->isInput() ||
+        dcl->isOutput() ||
+        dcl->isPayloadLiveOut() ||
+        dcl->isDoNotSpill() ||
+        lr->getEOTSrc() ||
+        gra.isLoopSplitTmp(dcl))
+        return false;
+
+    // copies are dword moves over the whole variable, addressing it linearly
+    if (dcl->getByteSize() % TypeSize(Type_UD) != 0)
+        return false;
+
+    if (dcl->getNumRows() > 1 &&
+        dcl->getNumElems() * dcl->getElemSize() != getGRFSize())
+        return false;
+
+    return true;
+}
+
+// Return the single BB outside the loop that branches to its header, or
+// nullptr if there is none that falls through only to the header.
+G4_BB* LoopSplit::getPreheader(Loop* loop) const
+{
+    G4_BB* preheader = nullptr;
+    for (auto pred : loop->getHeader()->Preds)
+    {
+        if (loop->contains(pred))
+            continue;
+        if (preheader)
+            return nullptr;
+        preheader = pred;
+    }
+
+    if (!preheader || preheader->Succs.size() != 1 ||
+        (preheader->getBBType() & G4_BB_CALL_TYPE))
+        return nullptr;
+
+    return preheader;
+}
+
+// Collect the BBs outside the loop that are reached from it. Return false if
+// one of them is also reached from outside the loop, as copies at its start
+// would then run on paths that never entered the loop.
+bool LoopSplit::getExits(Loop* loop, std::vector<G4_BB*>& exits) const
+{
+    bool dedicated = true;
+    for (auto bb : kernel.fg)
+    {
+        if (!loop->contains(bb))
+            continue;
+
+        for (auto succ : bb->Succs)
+        {
+            if (loop->contains(succ) ||
+                std::find(exits.begin(), exits.end(), succ) != exits.end())
+                continue;
+
+            for (auto pred : succ->Preds)
+            {
+                if (!loop->contains(pred))
+                    dedicated = false;
+            }
+            exits.push_back(succ);
+        }
+    }
+    return dedicated;
+}
+
+// Rewrite all references to dcl in the loop to use tmpDcl instead. This
+// includes the lifetime.start (pseudo_kill dst) and lifetime.end (pseudo use
+// src) of dcl, which must name the variable that is live in the loop.
+void LoopSplit::replaceInLoop(Loop* loop, G4_Declare* dcl, G4_Declare* tmpDcl)
+{
+    auto builder = kernel.fg.builder;
+
+    // alias of dcl -> same alias of tmpDcl
+    std::unordered_map<G4_Declare*, G4_Declare*> aliases;
+    auto getNewDcl = [&](G4_Declare* rgnDcl)
+    {
+        if (rgnDcl == dcl)
+            return tmpDcl;
+
+        auto& newAlias = aliases[rgnDcl];
+        if (!newAlias)
+        {
+            newAlias = builder->createTempVar(rgnDcl->getTotalElems(),
+                rgnDcl->getElemType(), rgnDcl->getSubRegAlign());
+            newAlias->setAliasDeclare(tmpDcl, rgnDcl->getOffsetFromBase());
+        }
+        return newAlias;
+    };
+
+    for (auto bb : kernel.fg)
+    {
+        if (!loop->contains(bb))
+            continue;
+
+        for (auto inst : *bb)
+        {
+            auto dst = inst->getDst();
+            if (dst && dst->getBase()->isRegVar() && dst->getTopDcl() == dcl)
+            {
+                auto newDcl = getNewDcl(dst->getBase()->asRegVar()->getDeclare());
+                auto newDst = builder->createDst(newDcl->getRegVar(), dst->getRegOff(),
+                    dst->getSubRegOff(), dst->getHorzStride(), dst->getType());
+                inst->setDest(newDst);
+            }
+
+            for (unsigned int i = 0; i != G4_MAX_SRCS; ++i)
+            {
+                auto src = inst->getSrc(i);
+                if (!src || !src->isSrcRegRegion())
+                    continue;
+
+                auto srcRgn = src->asSrcRegRegion();
+                if (!srcRgn->getBase()->isRegVar() || srcRgn->getTopDcl() != dcl)
+                    continue;
+
+                auto newDcl = getNewDcl(srcRgn->getBase()->asRegVar()->getDeclare());
+                auto newSrc = builder->createSrcRegRegion(srcRgn->getModifier(),
+                    srcRgn->getRegAccess(), newDcl->getRegVar(), srcRgn->getRegOff(),
+                    srcRgn->getSubRegOff(), srcRgn->getRegion(), srcRgn->getType());
+                inst->setSrc(newSrc, i);
+            }
+        }
+    }
+}
+
+// Copy srcDcl to dstDcl before it. Both have the same layout.
+void LoopSplit::insertCopy(G4_Declare* dstDcl, G4_Declare* srcDcl, G4_BB* bb, INST_LIST_ITER it)
+{
+    auto builder = kernel.fg.builder;
+    const unsigned int dwordsPerGRF = numEltPerGRF<Type_UD>();
+    const unsigned int numDwords = srcDcl->getByteSize() / TypeSize(Type_UD);
+
+    for (unsigned int offset = 0; offset < numDwords;)
+    {
+        unsigned int regOff = offset / dwordsPerGRF;
+        unsigned int subRegOff = offset % dwordsPerGRF;
+        unsigned int maxSize = std::min(std::min(numDwords - offset, dwordsPerGRF - subRegOff), 16u);
+        unsigned int execSize = 1;
+        while (execSize * 2 <= maxSize)
+        {
+            execSize *= 2;
+        }
+
+        auto dst = builder->createDst(dstDcl->getRegVar(), (short)regOff, (short)subRegOff,
+            1, Type_UD);
+        auto src = builder->createSrc(srcDcl->getRegVar(), (short)regOff, (short)subRegOff,
+            execSize == 1 ? builder->getRegionScalar() : builder->getRegionStride1(), Type_UD);
+        auto copy = builder->createMov(G4_ExecSize(execSize), dst, src, InstOpt_WriteEnable, false);
+        bb->insertBefore(it, copy);
+
+        // copies shouldnt be rematerialized
+        gra.addNoRemat(copy);
+
+        offset += execSize;
+        numCopies++;
+    }
+}
+
+void LoopSplit::run(const std::vector<const LiveRange*>& lrs, bool requireLiveOutside)
+{
+    // pressure isnt estimated in fast compile
+    if (lrs.empty() || rpe.getMaxRP() == 0)
+        return;
+
+    FlowGraph& fg = kernel.fg;
+
+    std::unordered_set<const G4_Declare*> candidates;
+    for (auto lr : lrs)
+    {
+        candidates.insert(lr->getDcl());
+    }
+
+    // Visit outer loops first so that a variable referenced in nested loops
+    // is split once around all of them.
+    std::vector<Loop*> worklist = fg.getLoops().getTopLoops();
+    while (!worklist.empty())
+    {
+        Loop* loop = worklist.back();
+        worklist.pop_back();
+        worklist.insert(worklist.end(), loop->immNested.begin(), loop->immNested.end());
+
+        unsigned int maxRP = 0;
+        bool hasCall = false;
+        std::unordered_map<const G4_Declare*, RefInfo> loopRefs;
+        for (auto bb : fg)
+        {
+            if (!loop->contains(bb))
+                continue;
+
+            if (bb->getBBType() & G4_BB_CALL_TYPE)
+            {
+                hasCall = true;
+                break;
+            }
+
+            uint64_t weight = GlobalRA::getRefCount(bb->getNestLevel());
+            for (auto inst : *bb)
+            {
+                maxRP = std::max(maxRP, rpe.getRegisterPressure(inst));
+
+                // lifetime.start/end are renamed with the variable but cost
+                // nothing, so they don't make a split more worthwhile, and
+                // lifetime.start doesn't make the loop define it
+                if (inst->isPseudoKill() || inst->isLifeTimeEnd())
+                    continue;
+
+                auto dst = inst->getDst();
+                if (dst && dst->getBase()->isRegVar() &&
+                    candidates.count(dst->getTopDcl()))
+                {
+                    auto& info = loopRefs[dst->getTopDcl()];
+                    info.weight += weight;
+                    info.hasDef = true;
+                }
+
+                for (unsigned int i = 0; i != G4_MAX_SRCS; ++i)
+                {
+                    auto src = inst->getSrc(i);
+                    if (src && src->isSrcRegRegion() &&
+                        src->asSrcRegRegion()->getBase()->isRegVar() &&
+                        candidates.count(src->getTopDcl()))
+                    {
+                        loopRefs[src->getTopDcl()].weight += weight;
+                    }
+                }
+            }
+        }
+
+        // The pressure estimate was computed with all candidates in
+        // registers. Splitting a variable into a temp leaves it unchanged,
+        // unless the variable stays live across the loop next to the temp,
+        // which is accounted for below.
+        if (hasCall || loopRefs.empty() ||
+            maxRP + GRFHeadroom > kernel.getNumRegTotal())
+            continue;
+
+        G4_BB* preheader = getPreheader(loop);
+        if (!preheader)
+            continue;
+
+        std::vector<G4_BB*> exits;
+        bool dedicatedExits = getExits(loop, exits);
+
+        G4_BB* header = loop->getHeader();
+        uint64_t preheaderWeight = GlobalRA::getRefCount(preheader->getNestLevel());
+        // GRFs taken in the loop by the variables that are live across it
+        // alongside their temps
+        unsigned int extraRP = 0;
+
+        for (auto lr : lrs)
+        {
+            G4_Declare* dcl = lr->getDcl();
+            auto it = loopRefs.find(dcl);
+            if (it == loopRefs.end())
+                continue;
+
+            const RefInfo& info = it->second;
+            if (info.hasDef && !dedicatedExits)
+                continue;
+
+            unsigned int id = lr->getVar()->getId();
+            bool copyInPreheader = liveness.isLiveAtEntry(header, id);
+            std::vector<G4_BB*> copyExits;
+            uint64_t copyWeight = copyInPreheader ? preheaderWeight : 0;
+            if (info.hasDef)
+            {
+                for (auto exitBB : exits)
+                {
+                    if (liveness.isLiveAtEntry(exitBB, id))
+                    {
+                        copyExits.push_back(exitBB);
+                        copyWeight += GlobalRA::getRefCount(exitBB->getNestLevel());
+                    }
+                }
+            }
+
+            if (copyWeight >= info.weight)
+                continue;
+
+            if (requireLiveOutside && !copyInPreheader && copyExits.empty())
+                continue;
+
+            // A variable that the loop doesn't define is not copied back, so
+            // if it is live at an exit it remains live through the loop.
+            if (!info.hasDef &&
+                std::any_of(exits.begin(), exits.end(),
+                    [&](G4_BB* exitBB) { return liveness.isLiveAtEntry(exitBB, id); }))
+            {
+                unsigned int rows = dcl->getNumRows();
+                if (maxRP + extraRP + rows + GRFHeadroom > kernel.getNumRegTotal())
+                    continue;
+                extraRP += rows;
+            }
+
+            auto name = kernel.fg.builder->getNameString(kernel.fg.mem, 50, "%s_LP%d",
+                dcl->getName(), loop->id);
+            G4_Declare* tmpDcl = kernel.fg.builder->createDeclareNoLookup(name, G4_GRF,
+                dcl->getNumElems(), dcl->getNumRows(), dcl->getElemType());
+            tmpDcl->copyAlign(dcl);
+            gra.copyAlignment(tmpDcl, dcl);
+            if (gra.getSubRegAlign(tmpDcl) == Any)
+            {
+                // dword copies
+                tmpDcl->setSubRegAlign(Even_Word);
+                gra.setSubRegAlign(tmpDcl, Even_Word);
+            }
+            gra.addLoopSplitTmp(tmpDcl);
+
+            replaceInLoop(loop, dcl, tmpDcl);
+
+            if (copyInPreheader)
+            {
+                auto insertIt = preheader->end();
+                if (!preheader->empty() && preheader->back()->isFlowControl())
+                {
+                    --insertIt;
+                }
+                insertCopy(tmpDcl, dcl, preheader, insertIt);
+            }
+
+            for (auto exitBB : copyExits)
+            {
+                auto insertIt = std::find_if(exitBB->begin(), exitBB->end(),
+                    [](G4_INST* inst) { return !inst->isLabel(); });
+                insertCopy(dcl, tmpDcl, exitBB, insertIt);
+            }
+
+            numSplits++;
+        }
+    }
+}
+
+void LoopSplit::dump(std::ostream& os) const
+{
+    os << "# live ranges split at loop boundaries: " << numSplits << std::endl;
+    os << "# copies added: " << numCopies << std::endl;
+}
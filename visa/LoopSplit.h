@@ -0,0 +1,77 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef __LOOPSPLIT_H__
+#define __LOOPSPLIT_H__
+
+#include "FlowGraph.h"
+#include "GraphColor.h"
+#include "RPE.h"
+
+#include <vector>
+
+namespace vISA
+{
+    // Splits live ranges at loop boundaries. The references to a variable
+    // in a loop are renamed to a new temp that is copied from the variable
+    // in the preheader and, if the loop defines the variable, copied back at
+    // the loop exits where it is live. The temp and the rest of the live
+    // range are then colored, and if need be spilled, separately.
+    //
+    // Used before spilling to keep long-lived values in registers through
+    // the loops that reference them, and by SpillManagerGRF to place the
+    // spill/fill code of a spilled variable at the boundaries of a loop.
+    class LoopSplit
+    {
+    private:
+        // GRFs kept free in a loop when a variable is split at its boundaries.
+        const unsigned int GRFHeadroom = 8;
+
+        GlobalRA& gra;
+        G4_Kernel& kernel;
+        const LivenessAnalysis& liveness;
+        RPE& rpe;
+
+        unsigned int numSplits = 0;
+        unsigned int numCopies = 0;
+
+        class RefInfo
+        {
+        public:
+            uint64_t weight = 0;
+            bool hasDef = false;
+        };
+
+        G4_BB* getPreheader(Loop* loop) const;
+        bool getExits(Loop* loop, std::vector<G4_BB*>& exits) const;
+        void replaceInLoop(Loop* loop, G4_Declare* dcl, G4_Declare* tmpDcl);
+        void insertCopy(G4_Declare* dstDcl, G4_Declare* srcDcl, G4_BB* bb, INST_LIST_ITER it);
+
+    public:
+        LoopSplit(GlobalRA& g, const LivenessAnalysis& l, RPE& r) :
+            gra(g), kernel(g.kernel), liveness(l), rpe(r)
+        {
+        }
+
+        // Return true if the variable of lr may be split. Callers check that
+        // lr is a GRF live range that is to be spilled.
+        static bool isCandidate(const GlobalRA& gra, const LiveRange* lr);
+
+        // Split each of lrs at the boundaries of the outermost loop where
+        // its references weigh more than the copies and the loop has
+        // registers to spare. With requireLiveOutside set, variables that
+        // are local to the loop are left alone since splitting would only
+        // rename them.
+        void run(const std::vector<const LiveRange*>& lrs, bool requireLiveOutside);
+
+        bool getChangesMade() const { return numSplits != 0; }
+
+        void dump(std::ostream& os = std::cerr) const;
+    };
+}
+#endif
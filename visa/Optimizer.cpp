@@ -724,7 +724,7 @@ void Optimizer::insertDummyMovForHWRSWA()
                 {
                     bool hasJmpIPred = false;
 
-                    for (BB_LIST_ITER biter = bb->Preds.begin(), E1 = bb->Preds.end(); biter != E1; ++biter)
+                    for (BB_EDGE_LIST_ITER biter = bb->Preds.begin(), E1 = bb->Preds.end(); biter != E1; ++biter)
                     {
                         G4_BB* predBB = (*biter);
                         G4_INST* predBBLastInst = NULL;
@@ -744,7 +744,7 @@ void Optimizer::insertDummyMovForHWRSWA()
                     G4_Label* newLabel = hasJmpIPred ? wa_bb->getLabel() : NULL;
 
                     //replace bb with wa_bb in the pred BB of bb.
-                    for (BB_LIST_ITER biter = bb->Preds.begin(), E1 = bb->Preds.end(); biter != E1; ++biter)
+                    for (BB_EDGE_LIST_ITER biter = bb->Preds.begin(), E1 = bb->Preds.end(); biter != E1; ++biter)
                     {
                         G4_BB* predBB = (*biter);
                         G4_INST* predBBLastInst = NULL;
@@ -758,7 +758,7 @@ void Optimizer::insertDummyMovForHWRSWA()
                             predBBLastInst->setSrc(newLabel, 0);
                         }
 
-                        for (BB_LIST_ITER succiter = predBB->Succs.begin(), E2 = predBB->Succs.end(); succiter != E2; ++succiter)
+                        for (BB_EDGE_LIST_ITER succiter = predBB->Succs.begin(), E2 = predBB->Succs.end(); succiter != E2; ++succiter)
                         {
                             if (*succiter == bb)
                             {
@@ -1772,7 +1772,7 @@ void Optimizer::fixEndIfWhileLabels()
          {
              // For break, the whileBB should be the physical predecessor of
              // break's first successor bb.
-             BB_LIST_ITER iter = bb->Succs.begin();
+             BB_EDGE_LIST_ITER iter = bb->Succs.begin();
              while (iter != bb->Succs.end())
              {
                  G4_BB * succBB = (*iter);
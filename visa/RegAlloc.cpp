@@ -1069,26 +1069,39 @@ void LivenessAnalysis::computeLiveness()
     // backward flow analysis to propagate uses (locate last uses)
     //
 
+    // Both sweeps visit every BB until nothing changes, so the order only
+    // affects how fast they converge. Uses flow backward and defs forward,
+    // so walk the cached RPO in reverse and in order respectively; this takes
+    // one pass plus one pass per loop nesting level instead of one pass per
+    // BB that is laid out against the flow.
+    startTimer(TimerID::LIVENESS_SOLVE);
+    const std::vector<G4_BB*>& rpo = fg.getCFGOrder().getRPO();
+    std::vector<G4_BB*> layoutOrder;
+    if (rpo.size() != fg.size())
+    {
+        // BBs whose ids are not unique are not numbered, fall back to layout
+        // order.
+        layoutOrder.assign(fg.begin(), fg.end());
+    }
+    const std::vector<G4_BB*>& order = layoutOrder.empty() ? rpo : layoutOrder;
+
     bool change = true;
 
     while (change)
     {
         change = false;
-        BB_LIST::iterator rit = fg.end();
-        do
+        for (auto rit = order.rbegin(), rie = order.rend(); rit != rie; ++rit)
         {
             //
             // use_out = use_in(s1) + use_in(s2) + ...
             // where s1 s2 ... are the successors of bb
             // use_in  = use_gen + (use_out - use_kill)
             //
-            --rit;
             if (contextFreeUseAnalyze((*rit), change))
             {
                 change = true;
             }
-
-        } while (rit != fg.begin());
+        }
     }
 
     //
@@ -1103,7 +1116,7 @@ void LivenessAnalysis::computeLiveness()
     while (change)
     {
         change = false;
-        for (auto bb : fg)
+        for (auto bb : order)
         {
             //
             // def_in   = def_out(p1) + def_out(p2) + ... where p1 p2 ... are the predecessors of bb
@@ -1115,6 +1128,7 @@ void LivenessAnalysis::computeLiveness()
             }
         }
     }
+    stopTimer(TimerID::LIVENESS_SOLVE);
 
 #if 0
     // debug code to compare old v. new IPA
@@ -13,6 +13,8 @@ SPDX-License-Identifier: MIT
 #include "GraphColor.h"
 #include "BuildIR.h"
 #include "DebugInfo.h"
+#include "RPE.h"
+#include "LoopSplit.h"
 
 #include <math.h>
 #include <sstream>
@@ -126,7 +128,8 @@ SpillManagerGRF::SpillManagerGRF(
     unsigned indrSpillRegSize,
     bool enableSpillSpaceCompression,
     bool useScratchMsg,
-    bool avoidDstSrcOverlap)
+    bool avoidDstSrcOverlap,
+    RPE* rpe)
     : gra(g)
     , builder_(g.kernel.fg.builder)
     , varIdCount_(varIdCount)
@@ -143,6 +146,7 @@ SpillManagerGRF::SpillManagerGRF(
     , useScratchMsg_(useScratchMsg)
     , avoidDstSrcOverlap_(avoidDstSrcOverlap)
     , refs(g.kernel)
+    , rpe_(rpe)
 {
     const unsigned size = sizeof(unsigned) * varIdCount;
     spillRangeCount_ = (unsigned*)allocMem(size);
@@ -4124,6 +4128,72 @@ void SpillManagerGRF::runSpillAnalysis()
     }
 }
 
+// Number of references to spilled variables, each weighted by the loop
+// nesting of its BB the same way spill costs are.
+uint64_t SpillManagerGRF::computeWeightedSpilledRefs() const
+{
+    uint64_t count = 0;
+    for (auto bb : gra.kernel.fg)
+    {
+        uint64_t weight = GlobalRA::getRefCount(bb->getNestLevel());
+        for (auto inst : *bb)
+        {
+            if (inst->isPseudoKill() || inst->isLifeTimeEnd())
+            {
+                continue;
+            }
+
+            auto dst = inst->getDst();
+            if (dst && dst->getBase()->isRegVar() &&
+                getRFType(dst) == G4_GRF && shouldSpillRegister(getRegVar(dst)))
+            {
+                count += weight;
+            }
+
+            for (unsigned i = 0; i < G4_MAX_SRCS; i++)
+            {
+                auto src = inst->getSrc(i);
+                if (src && src->isSrcRegRegion() &&
+                    src->asSrcRegRegion()->getBase()->isRegVar() &&
+                    getRFType(src->asSrcRegRegion()) == G4_GRF &&
+                    shouldSpillRegister(getRegVar(src->asSrcRegRegion())))
+                {
+                    count += weight;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Loop-aware placement of spill/fill code.
+//
+// By default every reference to a spilled variable gets its own spill or
+// fill. Instead, split spilled variables at the boundaries of the loops that
+// reference them. The copies to and from the loop temp still reference the
+// spilled variable, so the regular spill/fill insertion turns them into the
+// only fill and spills of the variable for that loop, while the temp is
+// colored by the next RA iteration.
+void SpillManagerGRF::placeSpillsAtLoopBoundaries()
+{
+    if (failSafeSpill_ || !rpe_)
+        return;
+
+    std::vector<const LiveRange*> candidates;
+    for (const LiveRange* lr : *spilledLRs_)
+    {
+        if (getRFType(lr->getVar()) == G4_GRF &&
+            shouldSpillRegister(lr->getVar()) &&
+            LoopSplit::isCandidate(gra, lr))
+        {
+            candidates.push_back(lr);
+        }
+    }
+
+    LoopSplit split(gra, *lvInfo_, *rpe_);
+    split.run(candidates, false);
+}
+
 // Insert spill/fill code for all registers that have not been assigned
 // physical registers in the current iteration of the graph coloring
 // allocator.
@@ -4164,6 +4234,14 @@ bool SpillManagerGRF::insertSpillFillCode(
         return false;
     }
 
+    weightedSpilledRefs = computeWeightedSpilledRefs();
+    weightedSpilledRefsAfterPlacement = weightedSpilledRefs;
+    if (builder_->getOption(vISA_SpillLoopPlacement))
+    {
+        placeSpillsAtLoopBoundaries();
+        weightedSpilledRefsAfterPlacement = computeWeightedSpilledRefs();
+    }
+
     // Insert spill/fill code for all basic blocks.
     updateRMWNeeded();
     FlowGraph& fg = kernel->fg;
@@ -36,6 +36,7 @@ class LiveRange;
 class LSLiveRange;
 class PointsToAnalysis;
 class GlobalRA;
+class RPE;
 }
 struct RegionDesc;
 // Class definitions
@@ -73,7 +74,8 @@ public:
         unsigned                 indrSpillRegSize,
         bool                     enableSpillSpaceCompression,
         bool                     useScratchMsg,
-        bool                     avoidDstSrcOverlap
+        bool                     avoidDstSrcOverlap,
+        RPE *                    rpe = nullptr
     );
 
     SpillManagerGRF(
@@ -104,6 +106,12 @@ public:
     unsigned getNumGRFSpill() const { return numGRFSpill; }
     unsigned getNumGRFFill() const { return numGRFFill; }
     unsigned getNumGRFMove() const { return numGRFMove; }
+    // References to the spilled variables weighted by the loop nesting of
+    // their BBs, before and after loop-aware placement. Both are counted
+    // before any spill code is inserted, so they are not spill/fill counts:
+    // spill cleanup and later RA iterations can still change those.
+    uint64_t getWeightedSpilledRefs() const { return weightedSpilledRefs; }
+    uint64_t getWeightedSpilledRefsAfterPlacement() const { return weightedSpilledRefsAfterPlacement; }
     // return the next cumulative logical offset. This does not non-spilled stuff like
     // private variables placed by IGC (marked by spill_mem_offset)
     // this should only be called after insertSpillFillCode()
@@ -632,6 +640,10 @@ private:
 
     VarReferences refs;
 
+    RPE* rpe_ = nullptr;
+    uint64_t weightedSpilledRefs = 0;
+    uint64_t weightedSpilledRefsAfterPlacement = 0;
+
     // analysis pass to assist in spill/fill code gen
     // currently it identifies scalar imm variables that should be re-mat
     // later on we can add detection to avoid unncessary read-modify-write for spills
@@ -641,6 +653,10 @@ private:
     bool checkDefUseDomRel(G4_DstRegRegion* dst, G4_BB* bb);
     void updateRMWNeeded();
 
+    // loop-aware placement of spill/fill code
+    uint64_t computeWeightedSpilledRefs() const;
+    void placeSpillsAtLoopBoundaries();
+
 
     bool headerNeeded() const
     {
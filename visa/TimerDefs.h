@@ -6,10 +6,14 @@ SPDX-License-Identifier: MIT
 
 ============================= end_copyright_notice ===========================*/
 
+// IGC records these into the TIME_VISA_* stats of IGC/common/timeStats.h
+// by position, so add a stat there in the same place for each new timer.
+//
 //        ENUM                                               DESCRIPTION
 DEF_TIMER(TOTAL,                                                  "Total")
 DEF_TIMER(BUILDER,                                             "IR_Build")
 DEF_TIMER(CFG,                                                      "CFG")
+DEF_TIMER(LOCAL_DATAFLOW,                                "Local_Dataflow")
 DEF_TIMER(OPTIMIZER,                                          "Optimizer")
 DEF_TIMER(HW_CONFORMITY,                                  "HW_Conformity")
 DEF_TIMER(MISC_OPTS,                                          "Misc_opts")
@@ -32,7 +36,9 @@ DEF_TIMER(VISA_BUILDER_CREATE_VAR,                        "VB_Create_Var")
 DEF_TIMER(VISA_BUILDER_CREATE_OPND,                   "VB_Create_Operand")
 DEF_TIMER(VISA_BUILDER_IR_CONSTRUCTION,              "VB_IR_Construction")
 DEF_TIMER(LIVENESS,                                            "liveness")
+DEF_TIMER(LIVENESS_SOLVE,                                "liveness_solve")
 DEF_TIMER(RPE,                                    "Reg Pressure Estimate")
+DEF_TIMER(DEBUG_INFO,                                        "Debug_Info")
 
 
 
@@ -649,6 +649,7 @@ public:
     VISA_BUILDER_API int GetCompilerStats(CompilerStats &compilerStats) override;
     VISA_BUILDER_API int GetErrorMessage(const char *&errorMsg) const override;
     VISA_BUILDER_API virtual int GetGenxDebugInfo(void *&buffer, unsigned int &size) const override;
+    VISA_BUILDER_API int TakeGenxDebugInfo(vISA::GenDebugInfo &info) override;
     /// GetGenRelocEntryBuffer -- allocate and return a buffer of all GenRelocEntry that are created by vISA
     VISA_BUILDER_API int GetGenRelocEntryBuffer(void *&buffer, unsigned int &byteSize, unsigned int &numEntries) override;
     /// GetRelocations -- add vISA created relocations into given relocation list
@@ -930,8 +931,10 @@ private:
 
     unsigned long m_genx_binary_size;
     char * m_genx_binary_buffer;
-    unsigned long m_genx_debug_info_size;
-    char * m_genx_debug_info_buffer;
+    // binary debug info, serialized from m_genx_debug_info on request
+    mutable unsigned long m_genx_debug_info_size;
+    mutable char * m_genx_debug_info_buffer;
+    vISA::GenDebugInfo m_genx_debug_info;
     FINALIZER_INFO* m_jitInfo;
     CompilerStats m_compilerStats;
 
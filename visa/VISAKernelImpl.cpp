@@ -601,6 +601,8 @@ void VISAKernelImpl::initCompilerStats()
     m_compilerStats.Init(CompilerStats::numGRFFillStr(), CompilerStats::type_int64);
     m_compilerStats.Init(CompilerStats::numSendStr(), CompilerStats::type_int64);
     m_compilerStats.Init(CompilerStats::numCyclesStr(), CompilerStats::type_int64);
+    m_compilerStats.Init(CompilerStats::debugInfoBytesStr(), CompilerStats::type_int64);
+    m_compilerStats.Init(CompilerStats::defUseBytesStr(), CompilerStats::type_int64);
 #if COMPILER_STATS_ENABLE
     m_compilerStats.Init("PreRASchedulerForPressure", CompilerStats::type_bool);
     m_compilerStats.Init("PreRASchedulerForLatency", CompilerStats::type_bool);
@@ -8186,12 +8188,31 @@ int VISAKernelImpl::GetGenRelocEntryBuffer(void *&buffer, unsigned int &byteSize
 
 int VISAKernelImpl::GetGenxDebugInfo(void *&buffer, unsigned int &size) const
 {
+    // Only offline consumers need the binary format, so it is not
+    // produced until it is asked for.
+    if (m_genx_debug_info_buffer == NULL && !m_genx_debug_info.empty())
+    {
+        void* ptr;
+        unsigned dbgSize;
+        emitDebugInfoToMem(m_genx_debug_info, ptr, dbgSize);
+        m_genx_debug_info_buffer = (char*)ptr;
+        m_genx_debug_info_size = dbgSize;
+    }
+
     buffer = m_genx_debug_info_buffer;
     size = m_genx_debug_info_size;
 
     return VISA_SUCCESS;
 }
 
+int VISAKernelImpl::TakeGenxDebugInfo(vISA::GenDebugInfo &info)
+{
+    info = std::move(m_genx_debug_info);
+    m_genx_debug_info.compiledObjs.clear();
+
+    return VISA_SUCCESS;
+}
+
 int VISAKernelImpl::GetJitInfo(FINALIZER_INFO *&jitInfo) const
 {
     jitInfo = m_jitInfo;
@@ -8656,6 +8677,8 @@ const char* VISAKernelImpl::getFunctionName() const
 
 void VISAKernelImpl::computeAndEmitDebugInfo(VISAKernelImplListTy& functions)
 {
+    TIME_SCOPE(DEBUG_INFO);
+
     std::list<VISAKernelImpl*> compilationUnitsForDebugInfo;
     compilationUnitsForDebugInfo.push_back(this);
     auto funcEndIt = functions.end();
@@ -8688,18 +8711,21 @@ void VISAKernelImpl::computeAndEmitDebugInfo(VISAKernelImplListTy& functions)
         curKernel.getKernelDebugInfo()->computeDebugInfo(stackCallEntryBBs);
     }
 
+    populateDebugInfo(this, functions, m_genx_debug_info);
+
+    if (getOptions()->getOption(vISA_EnableCompilerStats))
+    {
+        m_compilerStats.SetI64(CompilerStats::debugInfoBytesStr(),
+            getDebugInfoSize(m_genx_debug_info), m_kernel->getSimdSize());
+    }
+
 #ifndef DLL_MODE
     if (getOptions()->getOption(vISA_outputToFile))
     {
         std::string asmNameStr = getOutputAsmPath();
         std::string debugFileNameStr = asmNameStr + ".dbg";
-        emitDebugInfo(this, functions, debugFileNameStr);
+        emitDebugInfo(m_genx_debug_info, debugFileNameStr);
     }
-#else
-    void* ptr;
-    unsigned size;
-    emitDebugInfoToMem(this, functions, ptr, size);
-    setGenxDebugInfoBuffer((char*)ptr, size);
 #endif
 }
 
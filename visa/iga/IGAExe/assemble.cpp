@@ -8,6 +8,65 @@ SPDX-License-Identifier: MIT
 
 #include "iga_main.hpp"
 
+#include <chrono>
+
+static double timeAssemble(
+    const Opts &opts,
+    igax::Context &ctx,
+    const std::string &inpText,
+    const iga_assemble_options_t &aopts)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < opts.benchmarkIterations; i++) {
+        (void)ctx.assembleFromString(inpText, aopts);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// times the hand-written lexer against the flex-generated one
+// (and with -Xauto-deps, the cost of the SWSB analysis)
+static void benchmarkAssemble(
+    const Opts &opts,
+    igax::Context &ctx,
+    const std::string &inpText,
+    const igax::Bits &bits,
+    iga_assemble_options_t aopts)
+{
+    aopts.syntax_opts &= ~IGA_SYNTAX_OPT_FLEX_LEXER;
+    double fastSecs = timeAssemble(opts, ctx, inpText, aopts);
+    aopts.syntax_opts |= IGA_SYNTAX_OPT_FLEX_LEXER;
+    double flexSecs = timeAssemble(opts, ctx, inpText, aopts);
+    aopts.syntax_opts &= ~IGA_SYNTAX_OPT_FLEX_LEXER;
+
+    bool autoDeps =
+        (aopts.encoder_opts & IGA_ENCODER_OPT_AUTO_DEPENDENCIES) != 0;
+    double noDepsSecs = 0.0;
+    if (autoDeps) {
+        aopts.encoder_opts &= ~IGA_ENCODER_OPT_AUTO_DEPENDENCIES;
+        noDepsSecs = timeAssemble(opts, ctx, inpText, aopts);
+    }
+
+    size_t numInsts = countInstructions(bits);
+    double totalInsts = (double)numInsts * opts.benchmarkIterations;
+    auto rate = [&] (double secs) {
+        return secs > 0.0 ? totalInsts / secs : 0.0;
+    };
+    std::cerr << "assembled " << numInsts <<
+        " instructions x " << opts.benchmarkIterations << ":\n" <<
+        "  hand-written lexer: " << fastSecs << " s: " <<
+        rate(fastSecs) << " instructions/s\n" <<
+        "  flex lexer:         " << flexSecs << " s: " <<
+        rate(flexSecs) << " instructions/s\n";
+    if (autoDeps) {
+        std::cerr <<
+            "  without auto-deps:  " << noDepsSecs << " s: " <<
+            rate(noDepsSecs) << " instructions/s\n" <<
+            "  auto-deps overhead: " << (fastSecs - noDepsSecs) << " s\n";
+    }
+}
+
 
 bool assemble(
     const Opts &opts,
@@ -59,6 +118,9 @@ bool assemble(
     setOptBit(aopts.syntax_opts,
         IGA_SYNTAX_OPT_EXTENSIONS,
         opts.syntaxExts);
+    setOptBit(aopts.syntax_opts,
+        IGA_SYNTAX_OPT_FLEX_LEXER,
+        opts.useFlexLexer);
     aopts.sbid_count = opts.sbidCount;
 
     try {
@@ -67,6 +129,9 @@ bool assemble(
             emitWarningToStderr(w, inpText);
         }
         bits = r.value;
+        if (opts.benchmarkIterations > 0) {
+            benchmarkAssemble(opts, ctx, inpText, bits, aopts);
+        }
         return true;
     } catch (const igax::AssembleError &err) {
         for (auto &e : err.errors) {
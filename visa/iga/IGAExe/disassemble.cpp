@@ -8,6 +8,81 @@ SPDX-License-Identifier: MIT
 
 #include "iga_main.hpp"
 
+#include <chrono>
+
+// counts instructions by walking the compaction bits (bit 29)
+size_t countInstructions(const igax::Bits &bits)
+{
+    size_t n = 0;
+    for (size_t off = 0; off + 4 <= bits.size(); n++) {
+        uint32_t dw0;
+        memcpy(&dw0, bits.data() + off, sizeof(dw0));
+        off += (dw0 & (1u << 29)) ? 8 : 16;
+    }
+    return n;
+}
+
+static void writeInstText(int32_t, const char *text, size_t len, void *env)
+{
+    ((std::ostream *)env)->write(text, (std::streamsize)len);
+}
+static void discardInstText(int32_t, const char *, size_t, void *)
+{
+}
+
+static void benchmarkDisassemble(
+    const Opts &opts,
+    igax::Context &ctx,
+    const std::vector<unsigned char> &inp,
+    const iga_disassemble_options_t &dopts)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < opts.benchmarkIterations; i++) {
+        if (opts.streamOutput) {
+            (void)ctx.disassembleStreaming(
+                inp.data(), inp.size(), discardInstText, nullptr, dopts);
+        } else {
+            (void)ctx.disassembleToString(inp.data(), inp.size(), dopts);
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    size_t numInsts = countInstructions(inp);
+    double totalInsts = (double)numInsts * opts.benchmarkIterations;
+    std::cerr << "disassembled " << numInsts <<
+        " instructions x " << opts.benchmarkIterations << " in " <<
+        elapsed.count() << " s: " <<
+        (elapsed.count() > 0.0 ? totalInsts / elapsed.count() : 0.0) <<
+        " instructions/s\n";
+}
+
+// writes the output as it is formatted instead of building the listing
+static std::vector<igax::Diagnostic> disassembleStreaming(
+    const Opts &opts,
+    igax::Context &ctx,
+    const std::vector<unsigned char> &inp,
+    const iga_disassemble_options_t &dopts)
+{
+    std::ofstream file;
+    std::ostream *os = &std::cout;
+    if (opts.outputFile != "") {
+        file.open(opts.outputFile);
+        if (!file.good()) {
+            fatalExitWithMessage(opts.outputFile,
+                ": failed to open file (", iga::LastErrorString(), ")");
+        }
+        os = &file;
+    }
+    auto ws = ctx.disassembleStreaming(
+        inp.data(), inp.size(), writeInstText, os, dopts);
+    if (!os->good()) {
+        fatalExitWithMessage(
+            opts.outputFile == "" ? "<<stdout>>" : opts.outputFile,
+            ": error writing (", iga::LastErrorString(), ")");
+    }
+    return ws;
+}
 
 bool disassemble(
     const Opts &opts, igax::Context &ctx, const std::string &inpFile)
@@ -24,7 +99,19 @@ bool disassemble(
     setOptBit(dopts.decoder_opts,
         IGA_DECODING_OPT_NATIVE,
         opts.useNativeEncoder);
+    setOptBit(dopts.decoder_opts,
+        IGA_DECODING_OPT_PARALLEL,
+        opts.parallelDecode);
     try {
+        if (opts.benchmarkIterations > 0) {
+            benchmarkDisassemble(opts, ctx, inp, dopts);
+        }
+        if (opts.streamOutput) {
+            for (auto &w : disassembleStreaming(opts, ctx, inp, dopts)) {
+                emitWarningToStderr(w, inp);
+            }
+            return true;
+        }
         auto r = ctx.disassembleToString(inp.data(), inp.size(), dopts);
         for (auto &w : r.warnings) {
             emitWarningToStderr(w, inp);
@@ -41,7 +128,8 @@ bool disassemble(
             //      invalid project for instance
             err.emit(std::cerr);
         }
-        if (opts.outputOnFail)
+        // streamed output has already been written
+        if (opts.outputOnFail && !opts.streamOutput)
             writeText(opts, err.outputText);
     } catch (const igax::Error &err) {
         // some other error
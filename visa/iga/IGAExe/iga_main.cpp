@@ -313,6 +313,20 @@ extern "C" int iga_main(int argc, const char **argv)
         "the compacted form does not exist.",
         opts::OptAttrs::ALLOW_UNSET,
         baseOpts.autoCompact);
+    xGrp.defineOpt(
+        "bench",
+        "bench",
+        "INT",
+        "repeats the operation INT times and reports throughput",
+        "The input is processed the given number of times and the "
+        "throughput (in instructions per second) is written to stderr. "
+        "For assembly, the hand-written and flex lexers are each timed. "
+        "The output is still produced once.",
+        opts::OptAttrs::ALLOW_UNSET,
+        [] (const char *cinp, const opts::ErrorHandler &eh, Opts &baseOpts) {
+            baseOpts.benchmarkIterations = eh.parseInt(cinp);
+        }
+    );
     xGrp.defineFlag(
         "dcmp",
         nullptr,
@@ -406,6 +420,32 @@ extern "C" int iga_main(int argc, const char **argv)
         "",
         opts::OptAttrs::ALLOW_UNSET,
         baseOpts.useNativeEncoder);
+    xGrp.defineFlag(
+        "flex-lexer",
+        nullptr,
+        "assembles with the legacy flex-generated lexer",
+        "The default lexer is hand-written; this selects the original "
+        "flex-generated one, which accepts the same syntax.  "
+        "With -Xbench, both lexers are timed regardless.",
+        opts::OptAttrs::ALLOW_UNSET,
+        baseOpts.useFlexLexer);
+    xGrp.defineFlag(
+        "parallel-decode",
+        nullptr,
+        "decodes large kernels on multiple threads",
+        "The binary is split into chunks of instructions that are decoded "
+        "concurrently; the output is identical to a sequential decode.",
+        opts::OptAttrs::ALLOW_UNSET,
+        baseOpts.parallelDecode);
+    xGrp.defineFlag(
+        "stream-output",
+        nullptr,
+        "writes disassembly an instruction at a time",
+        "Instructions are written as they are formatted via "
+        "iga_context_disassemble_streaming instead of building the "
+        "entire listing in memory first.",
+        opts::OptAttrs::ALLOW_UNSET,
+        baseOpts.streamOutput);
     xGrp.defineFlag(
         "no-autocompact",
         nullptr,
@@ -56,6 +56,7 @@ struct Opts {
     uint32_t sbidCount       = 16;                   // -Xsbid-count
     bool syntaxExts          = false;                // -Xsyntax-exts
     bool useNativeEncoder    = false;                // -Xnative
+    bool useFlexLexer        = false;                // -Xflex-lexer
 
     bool printBits           = false;                // -Xprint-bits
     bool printDefs           = false;                // -Xprint-defs
@@ -65,6 +66,9 @@ struct Opts {
     bool printBfnExprs       = true;                 // -Xprint-bfnexprs
     bool printLdSt           = false;                // -Xprint-ldst
     bool printInstructionPc  = false;                // -Xprint-pc
+    bool parallelDecode      = false;                // -Xparallel-decode
+    bool streamOutput        = false;                // -Xstream-output
+    int benchmarkIterations  = 0;                    // -Xbench
 };
 
 bool disassemble(
@@ -81,6 +85,8 @@ bool assemble(
     const std::string &inpFile,
     const std::string &inpText,
     igax::Bits &bits); // assemble.cpp
+size_t countInstructions(
+    const igax::Bits &bits); // disassemble.cpp
 bool decodeInstructionFields(
     const Opts &baseOpts); // -Xifs in decode_fields.cpp
 bool debugCompaction(
@@ -13,9 +13,14 @@ namespace iga
 struct DecoderOpts
 {
     bool useNumericLabels;
+    // decode large binaries in chunks on several threads
+    bool parallelDecode;
 
-    DecoderOpts(bool _useNumericLabels = false)
+    DecoderOpts(
+        bool _useNumericLabels = false,
+        bool _parallelDecode = false)
         : useNumericLabels(_useNumericLabels)
+        , parallelDecode(_parallelDecode)
     {
     }
 };
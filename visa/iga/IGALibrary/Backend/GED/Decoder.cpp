@@ -18,8 +18,13 @@ SPDX-License-Identifier: MIT
 #include "../../IR/SWSBSetter.hpp"
 #include "../../MemManager/MemManager.hpp"
 
-#include <sstream>
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 
 
@@ -174,11 +179,19 @@ Kernel *Decoder::decodeKernel(
     // insts.reserve(binarySize / 8 + 1);
 
     // Pass 1. decode them all into Instruction objects
-    decodeInstructions(
-        *kernel,
-        binary,
-        binarySize,
-        insts);
+    if (m_parallelDecode) {
+        decodeInstructionsParallel(
+            *kernel,
+            binary,
+            binarySize,
+            insts);
+    } else {
+        decodeInstructions(
+            *kernel,
+            binary,
+            binarySize,
+            insts);
+    }
 
     if (numericLabels) {
         Block *block = kernel->createBlock();
@@ -281,11 +294,124 @@ void Decoder::decodeInstructions(
     size_t binarySize,
     InstList &insts)
 {
-    restart();
-    uint32_t nextId = 1;
+    decodeInstructionRange(
+        kernel, binaryStart, 0, (int32_t)binarySize, 1, insts);
+}
+
+// instructions per chunk for parallel decoding
+static const size_t PARALLEL_DECODE_CHUNK_SIZE = 4 * 1024;
+
+void Decoder::decodeInstructionsParallel(
+    Kernel &kernel,
+    const void *binaryStart,
+    size_t binarySize,
+    InstList &insts)
+{
+    // Pass 0. find chunk boundaries by walking the compaction bits; this
+    // has to follow the same padding rules as decodeInstructionRange so
+    // that only the final chunk can end in a partial instruction
+    struct Chunk {
+        int32_t startPc;
+        int32_t endPc;
+        uint32_t firstId;
+        ErrorHandler errors;
+        // owns the instructions' memory until merged into the kernel
+        std::unique_ptr<Kernel> kernel;
+        std::vector<Instruction *> insts;
+        bool fatal = false;
+    };
+    std::vector<std::unique_ptr<Chunk>> chunks;
+
     const unsigned char *binary = (const unsigned char *)binaryStart;
+    int32_t pc = 0;
+    uint32_t numInsts = 0;
+    while (pc + 4 <= (int32_t)binarySize) {
+        if (numInsts % PARALLEL_DECODE_CHUNK_SIZE == 0) {
+            if (!chunks.empty())
+                chunks.back()->endPc = pc;
+            chunks.emplace_back(new Chunk());
+            chunks.back()->startPc = pc;
+            chunks.back()->firstId = numInsts + 1;
+        }
+        uint32_t dw0;
+        memcpy(&dw0, binary + pc, sizeof(dw0));
+        int32_t iLen = ((dw0 >> COMPACTION_CONTROL) & 1) != 0 ?
+            COMPACTED_SIZE :
+            UNCOMPACTED_SIZE;
+        if (pc + iLen > (int32_t)binarySize)
+            break;
+        pc += iLen;
+        numInsts++;
+    }
+
+    unsigned numThreads = std::min<unsigned>(
+        std::max(1u, std::thread::hardware_concurrency()),
+        (unsigned)chunks.size());
+    if (numThreads <= 1) {
+        decodeInstructions(kernel, binaryStart, binarySize, insts);
+        return;
+    }
+    chunks.back()->endPc = (int32_t)binarySize;
+
+    // Pass 1. decode the chunks on a pool of threads; each thread uses its
+    // own Decoder, ErrorHandler and Kernel (for memory) per chunk
+    std::atomic<size_t> nextChunk(0);
+    auto worker = [&]() {
+        for (size_t ci = nextChunk++; ci < chunks.size(); ci = nextChunk++) {
+            Chunk &c = *chunks[ci];
+            c.kernel.reset(new Kernel(m_model));
+            c.insts.reserve(PARALLEL_DECODE_CHUNK_SIZE);
+            Decoder d(m_model, c.errors);
+            d.setSWSBEncodingMode(m_SWSBEncodeMode);
+            try {
+                d.decodeInstructionRange(
+                    *c.kernel, binaryStart,
+                    c.startPc, c.endPc, c.firstId, c.insts);
+            } catch (const FatalError &) {
+                c.fatal = true;
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(numThreads - 1);
+    for (unsigned i = 1; i < numThreads; i++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+
+    // merge in order; diagnostics stay sorted by PC as in a sequential
+    // decode and a fatal error stops at the chunk that raised it
+    for (auto &c : chunks) {
+        kernel.getMemManager().adopt(c->kernel->getMemManager());
+        for (Instruction *inst : c->insts)
+            insts.emplace_back(inst);
+        for (const Diagnostic &d : c->errors.getWarnings())
+            errorHandler().reportWarning(d.at, d.message);
+        for (const Diagnostic &d : c->errors.getErrors())
+            errorHandler().reportError(d.at, d.message);
+        if (c->fatal)
+            throw FatalError();
+    }
+}
+
+template <typename InstContainer>
+void Decoder::decodeInstructionRange(
+    Kernel &kernel,
+    const void *binaryStart,
+    int32_t startPc,
+    int32_t endPc,
+    uint32_t firstId,
+    InstContainer &insts)
+{
+    restart();
+    m_binary = binaryStart;
+    setPc(startPc);
+    uint32_t nextId = firstId;
+    const unsigned char *binary =
+        (const unsigned char *)binaryStart + startPc;
 
-    int32_t bytesLeft =  (int32_t)binarySize;
+    int32_t bytesLeft = endPc - startPc;
     while (bytesLeft > 0)
     {
         // need at least 4 bytes to check compaction control
@@ -303,7 +429,7 @@ void Decoder::decodeInstructions(
         }
         memset(&m_currGedInst, 0, sizeof(m_currGedInst));
         GED_RETURN_VALUE status =
-            GED_DecodeIns(m_gedModel, binary, (uint32_t)binarySize, &m_currGedInst);
+            GED_DecodeIns(m_gedModel, binary, (uint32_t)bytesLeft, &m_currGedInst);
         Instruction *inst = nullptr;
         if (status == GED_RETURN_VALUE_NO_COMPACT_FORM) {
             errorT("error decoding instruction (no compacted form)");
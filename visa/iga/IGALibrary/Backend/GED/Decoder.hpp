@@ -122,6 +122,10 @@ namespace iga
             }
         }
 
+        // Decode large binaries in fixed-size chunks of instructions on
+        // a pool of threads; the result is identical to a sequential decode
+        void setParallelDecode(bool enable) { m_parallelDecode = enable; }
+
         bool isMacro() const;
 
     private:
@@ -136,6 +140,24 @@ namespace iga
             const void *binary,
             size_t binarySize,
             InstList &insts);
+        // same as above, but splits the binary into chunks at instruction
+        // boundaries (found via compaction bits) and decodes those
+        // concurrently with one Decoder per chunk
+        void decodeInstructionsParallel(
+            Kernel &kernel,
+            const void *binary,
+            size_t binarySize,
+            InstList &insts);
+        // decodes the instructions in [startPc, endPc) of the binary,
+        // numbering them from firstId
+        template <typename InstContainer>
+        void decodeInstructionRange(
+            Kernel &kernel,
+            const void *binary,
+            int32_t startPc,
+            int32_t endPc,
+            uint32_t firstId,
+            InstContainer &insts);
         const OpSpec *decodeOpSpec(Op op);
 
         Instruction *decodeNextInstruction(Kernel &kernel);
@@ -405,6 +427,8 @@ namespace iga
         // SWSB encoding mode
         SWSB_ENCODE_MODE m_SWSBEncodeMode = SWSB_ENCODE_MODE::SWSBInvalidMode;
 
+        bool m_parallelDecode = false;
+
         // for GED workarounds: grab specific bits from the current instruction
         uint32_t getBitField(int ix, int len) const;
 
@@ -46,6 +46,11 @@ struct Token {
     }
 };
 
+// Scans all of 'inp' into 'tokens' (ending with END_OF_FILE) using the
+// hand-written scanner in Lexer.cpp.  It accepts the same language as
+// LexicalSpec.flex and produces the same tokens and locations.
+void ScanTokens(const std::string &inp, std::vector<Token> &tokens);
+
 static void WriteTokenContext(
     const std::string &inp,
     const struct Loc &loc,
@@ -94,15 +99,28 @@ class BufferedLexer {
     Token               m_eof;
 
 public:
-    BufferedLexer(const std::string &inp)
+    // useFlexLexer selects the original flex-generated scanner;
+    // it's slower, but retained as a reference and for benchmarking
+    BufferedLexer(const std::string &inp, bool useFlexLexer = false)
         : m_offset(0), m_mark(0)
         , m_input(inp)
         , m_eof(Lexeme::END_OF_FILE, 0, 0, 0, 0)
     {
+        if (useFlexLexer) {
+            scanWithFlex();
+        } else {
+            ScanTokens(m_input, m_tokens);
+            m_eof = m_tokens.back();
+        }
+    }
+    const std::string &GetSource() const {return m_input;}
+
+private:
+    void scanWithFlex() {
         yyscan_t yy;
 
         yylex_init(&yy);
-        yy_scan_string(inp.c_str(), yy);
+        yy_scan_string(m_input.c_str(), yy);
         yyset_lineno(1, yy);
         yyset_column(1, yy);
 
@@ -142,8 +160,8 @@ public:
 
         yylex_destroy(yy);
     }
-    const std::string &GetSource() const {return m_input;}
 
+public:
     size_t GetTokenOffset() const {
         return m_offset;
     }
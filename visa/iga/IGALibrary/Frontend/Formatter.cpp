@@ -45,6 +45,7 @@ protected:
     struct ColumnPreferences     cols;
     const Instruction           *currInst;
     const uint8_t               *currInstBits = nullptr; // optional to render encoding inline
+    std::stringstream            eolComments; // reused by each instruction
 
     ansi_esc ANSI_FADED;
     ansi_esc ANSI_REGISTER(RegName rnm) const  {
@@ -148,6 +149,19 @@ public:
     void formatKernel(
         const Kernel& k,
         const void *vbits)
+    {
+        formatKernel(k, vbits, [](int32_t) { });
+    }
+
+
+    // calls instFinished(pc) after each instruction's line is complete
+    // (and after any block that has no instructions); streaming clients
+    // use this to drain the output stream
+    template <typename F>
+    void formatKernel(
+        const Kernel& k,
+        const void *vbits,
+        F instFinished)
     {
         currInstBits = (const uint8_t *)vbits;
         if (opts.printInstDefs && opts.liveAnalysis) {
@@ -180,15 +194,20 @@ public:
                 newline();
             }
 
-            formatBlockContents(*b);
+            formatBlockContents(*b, instFinished);
+            if (b->getInstList().empty()) {
+                instFinished(b->getPC());
+            }
         }
     }
 
 
-    void formatBlockContents(const Block& b) {
+    template <typename F>
+    void formatBlockContents(const Block& b, F instFinished) {
         for (const auto &i : b.getInstList()) {
             formatInstruction(*i);
             newline();
+            instFinished(i->getPC());
 
             if (currInstBits) {
                 currInstBits += i->hasInstOpt(InstOpt::COMPACTED) ? 8 : 16;
@@ -716,7 +735,9 @@ private:
         const std::string &debugSendDecode = "",
         bool decodeSendDesc = true)
     {
-        std::stringstream ss;
+        std::stringstream &ss = eolComments;
+        ss.str(std::string());
+        ss.clear();
 
         // separate all comments with a semicolon
         Intercalator semiColon(ss, "; ");
@@ -807,7 +828,7 @@ private:
 
         if (ss.tellp() > 0) {
             // only add the comment if we emitted something
-            emitAnsi(ANSI_COMMENT, " // ", ss.str());
+            emitAnsi(ANSI_COMMENT, " // ", ss.rdbuf());
         }
     }
 
@@ -1449,6 +1470,99 @@ void FormatKernel(
 }
 
 
+// A stream buffer that writes into a caller-owned buffer.  Text that
+// doesn't fit moves to an internal spill buffer; both are rewound by
+// reset() so that neither is reallocated once it is large enough.
+class ReusableStreamBuffer : public std::streambuf
+{
+    char              *userBuf;
+    size_t             userBufLen;
+    std::vector<char>  spill;
+
+public:
+    ReusableStreamBuffer(char *buf, size_t bufLen)
+        : userBuf(buf), userBufLen(buf ? bufLen : 0)
+    {
+        reset();
+    }
+
+    const char *data() const {return pbase();}
+    size_t size() const {return (size_t)(pptr() - pbase());}
+
+    void reset() {
+        if (userBufLen > 0) {
+            setp(userBuf, userBuf + userBufLen);
+        } else {
+            setp(spill.data(), spill.data() + spill.size());
+        }
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        const size_t len = size();
+        const size_t cap = std::max<size_t>(
+            std::max<size_t>(256, 2 * (size_t)(epptr() - pbase())),
+            spill.size());
+        const bool inUserBuf = userBufLen > 0 && pbase() == userBuf;
+        spill.resize(cap);
+        if (inUserBuf) {
+            memcpy(spill.data(), userBuf, len);
+        }
+        setp(spill.data(), spill.data() + spill.size());
+        pbump((int)len);
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    // the formatter only needs tellp() for column alignment
+    pos_type seekoff(
+        off_type off,
+        std::ios_base::seekdir dir,
+        std::ios_base::openmode which) override
+    {
+        if (off != 0 || dir != std::ios_base::cur ||
+            (which & std::ios_base::out) == 0)
+        {
+            return pos_type(off_type(-1));
+        }
+        return pos_type((off_type)size());
+    }
+};
+
+
+void FormatKernelStreaming(
+    ErrorHandler &e,
+    const FormatOpts &opts,
+    const Kernel &k,
+    const void *bits,
+    char *buf,
+    size_t bufLen,
+    FormatInstCallback callback,
+    void *callbackEnv)
+{
+    IGA_ASSERT(k.getModel().platform == opts.model.platform,
+        "kernel and options must have same platform");
+    ReusableStreamBuffer sb(buf, bufLen);
+    std::ostream o(&sb);
+    auto drain = [&](int32_t pc) {
+        if (sb.size() > 0) {
+            (*callback)(pc, sb.data(), sb.size(), callbackEnv);
+            sb.reset();
+        }
+    };
+    if (!opts.printJson) {
+        Formatter f(e, o, opts);
+        f.formatKernel(k, (const uint8_t *)bits, drain);
+    } else {
+        FormatJSON(o, opts, k, bits);
+        drain(0);
+    }
+}
+
+
 void FormatInstruction(
     ErrorHandler& e,
     std::ostream& o,
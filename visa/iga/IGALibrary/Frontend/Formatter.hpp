@@ -90,6 +90,28 @@ namespace iga {
         const Kernel &k,
         const void *bits = nullptr);
 
+    // Receives the text of one instruction from FormatKernelStreaming
+    // (pc, text, text length, environment).  The text includes any block
+    // label preceding the instruction and the trailing newline; it isn't
+    // NUL-terminated and is only valid until the callback returns.
+    typedef void (*FormatInstCallback)(int32_t, const char *, size_t, void *);
+
+    // Formats a kernel an instruction at a time instead of accumulating
+    // the whole listing.  Each instruction is formatted into 'buf', which
+    // is reused for the next one; text exceeding 'bufLen' goes to an
+    // internal buffer that is likewise reused.  Concatenating the callback
+    // text reproduces FormatKernel's output.  JSON output isn't
+    // line-oriented and is passed to the callback in one piece.
+    void FormatKernelStreaming(
+        ErrorHandler &e,
+        const FormatOpts &opts,
+        const Kernel &k,
+        const void *bits,
+        char *buf,
+        size_t bufLen,
+        FormatInstCallback callback,
+        void *callbackEnv);
+
     void FormatInstruction(
         ErrorHandler &e,
         std::ostream &o,
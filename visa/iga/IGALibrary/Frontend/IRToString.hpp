@@ -545,36 +545,43 @@ static inline std::string ToSyntax(MathMacroExt MathMacroReg) {
 
 
 static inline std::string ToSyntax(const Region &rgn) {
-    std::stringstream ss;
+    // this runs for almost every operand; appending to a string avoids
+    // setting up a stream and the result fits in the small string buffer
+    std::string s;
 
     if (rgn.getVt() != Region::Vert::VT_INVALID &&
         rgn.getWi() != Region::Width::WI_INVALID &&
         rgn.getHz() != Region::Horz::HZ_INVALID)
     {
         if (rgn.getVt() == Region::Vert::VT_VxH) {
-            ss << "<" << (int)rgn.w << "," << (int)rgn.h << ">";
+            s += "<" + std::to_string((int)rgn.w) +
+                "," + std::to_string((int)rgn.h) + ">";
         } else {
-            ss << "<" << (int)rgn.v << ";" <<
-                (int)rgn.w << "," << (int)rgn.h << ">";
+            s += "<" + std::to_string((int)rgn.v) +
+                ";" + std::to_string((int)rgn.w) +
+                "," + std::to_string((int)rgn.h) + ">";
         }
     } else if (
         rgn.getVt() != Region::Vert::VT_INVALID &&
         rgn.getWi() == Region::Width::WI_INVALID &&
         rgn.getHz() != Region::Horz::HZ_INVALID)
     {
-        ss << "<" << (int)rgn.v << ";" << (int)rgn.h << ">";
+        s += "<" + std::to_string((int)rgn.v) +
+            ";" + std::to_string((int)rgn.h) + ">";
     } else if (
         rgn.getVt() == Region::Vert::VT_INVALID &&
         rgn.getWi() == Region::Width::WI_INVALID &&
         rgn.getHz() != Region::Horz::HZ_INVALID)
     {
-        ss << "<" << (int)rgn.h << ">";
+        s += "<" + std::to_string((int)rgn.h) + ">";
     } else if (rgn == Region::INVALID) {
-        ss << "Region::INVALID";
+        s = "Region::INVALID";
     } else {
+        std::stringstream ss;
         ss << "<0x" << std::hex << (int)rgn.bits << "?>";
+        s = ss.str();
     }
-    return ss.str();
+    return s;
 }
 
 
@@ -144,7 +144,7 @@ GenParser::GenParser(
     const std::string &inp,
     ErrorHandler &eh,
     const ParseOpts &pots)
-    : Parser(inp,eh)
+    : Parser(inp, eh, pots.useFlexLexer)
     , m_model(model)
     , m_builder(handler)
     , m_opts(pots)
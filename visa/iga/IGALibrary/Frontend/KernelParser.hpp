@@ -34,6 +34,10 @@ namespace iga {
         // before we give up on the parse
         size_t maxSyntaxErrors = 3;
 
+        // scans with the original flex-generated lexer instead of
+        // the hand-written one (for comparison and benchmarking)
+        bool useFlexLexer = false;
+
         ParseOpts(const Model &model) {
             swsbEncodeMode = model.getSWSBEncodeMode();
         }
@@ -0,0 +1,308 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2017-2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "BufferedLexer.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+// A hand-written scanner for the language in LexicalSpec.flex.
+// The whole input is scanned in one pass.  Every character is classified
+// through a table, so most tokens cost a table load and a switch.
+// The tokens and locations must match the flex scanner exactly since
+// diagnostics (and tools diffing them) depend on them; if you change
+// LexicalSpec.flex, change this as well.
+
+using namespace iga;
+
+namespace {
+
+enum CharClass : uint8_t {
+    CC_ERROR = 0, // anything else (including string delimiters)
+    CC_SPACE,     // [ \t\r]
+    CC_NEWLINE,   // \n
+    CC_DIGIT,     // [0-9]
+    CC_IDENT,     // [_a-zA-Z]
+    CC_PUNCT,     // a single character lexeme (see CharTables::punct)
+    CC_PREFIX,    // ( < > / which can start a longer lexeme
+};
+
+struct CharTables {
+    CharClass  cls[256];
+    Lexeme     punct[256];
+
+    void setPunct(char c, Lexeme lxm) {
+        cls[(uint8_t)c] = CC_PUNCT;
+        punct[(uint8_t)c] = lxm;
+    }
+
+    CharTables() {
+        for (int i = 0; i < 256; i++) {
+            cls[i] = CC_ERROR;
+            punct[i] = Lexeme::LEXICAL_ERROR;
+        }
+        cls[(uint8_t)' '] = cls[(uint8_t)'\t'] = cls[(uint8_t)'\r'] = CC_SPACE;
+        cls[(uint8_t)'\n'] = CC_NEWLINE;
+        for (int c = '0'; c <= '9'; c++)
+            cls[c] = CC_DIGIT;
+        for (int c = 'a'; c <= 'z'; c++)
+            cls[c] = CC_IDENT;
+        for (int c = 'A'; c <= 'Z'; c++)
+            cls[c] = CC_IDENT;
+        cls[(uint8_t)'_'] = CC_IDENT;
+
+        setPunct('[', Lexeme::LBRACK);
+        setPunct(']', Lexeme::RBRACK);
+        setPunct('{', Lexeme::LBRACE);
+        setPunct('}', Lexeme::RBRACE);
+        setPunct(')', Lexeme::RPAREN);
+        setPunct('$', Lexeme::DOLLAR);
+        setPunct('.', Lexeme::DOT);
+        setPunct(',', Lexeme::COMMA);
+        setPunct(';', Lexeme::SEMI);
+        setPunct(':', Lexeme::COLON);
+        setPunct('~', Lexeme::TILDE);
+        setPunct('!', Lexeme::BANG);
+        setPunct('@', Lexeme::AT);
+        setPunct('#', Lexeme::HASH);
+        setPunct('=', Lexeme::EQ);
+        setPunct('%', Lexeme::MOD);
+        setPunct('*', Lexeme::MUL);
+        setPunct('+', Lexeme::ADD);
+        setPunct('-', Lexeme::SUB);
+        setPunct('&', Lexeme::AMP);
+        setPunct('^', Lexeme::CIRC);
+        setPunct('|', Lexeme::PIPE);
+
+        cls[(uint8_t)'('] = cls[(uint8_t)'<'] = cls[(uint8_t)'>'] =
+            cls[(uint8_t)'/'] = CC_PREFIX;
+    }
+};
+
+static const CharTables s_tables;
+
+static inline bool isDec(char c) {
+    return c >= '0' && c <= '9';
+}
+static inline bool isHex(char c) {
+    return isDec(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+static inline bool isIdentChar(char c) {
+    CharClass cc = s_tables.cls[(uint8_t)c];
+    return cc == CC_IDENT || cc == CC_DIGIT;
+}
+
+// matches [eE][-+]?[0-9]+ (or [pP]... for hex floats) at p;
+// returns nullptr on mismatch
+static const char *scanExponent(
+    const char *p, const char *end, char e1, char e2)
+{
+    if (p == end || (*p != e1 && *p != e2))
+        return nullptr;
+    p++;
+    if (p != end && (*p == '-' || *p == '+'))
+        p++;
+    const char *digits = p;
+    while (p != end && isDec(*p))
+        p++;
+    return p == digits ? nullptr : p;
+}
+
+// Returns the end of the longest numeric pattern at s (which must be a
+// decimal digit).  Like flex, ties go to the pattern listed first in
+// LexicalSpec.flex.
+static const char *scanNumber(
+    const char *s, const char *end, Lexeme &lxm)
+{
+    const char *p = s;
+    while (p != end && isDec(*p))
+        p++;
+
+    const char *best = p;
+    lxm = Lexeme::INTLIT10;
+    auto longer = [&](const char *q, Lexeme qlxm) {
+        if (q != nullptr && q > best) {
+            best = q;
+            lxm = qlxm;
+        }
+    };
+
+    if (*s == '0' && s + 1 != end && (s[1] == 'x' || s[1] == 'X')) {
+        // 0x13 and hex floats 0x1.2p3, 0x.2p3, 0x1.p3, 0x1p3
+        const char *ds = s + 2, *q = ds;
+        while (q != end && isHex(*q))
+            q++;
+        if (q > ds)
+            longer(q, Lexeme::INTLIT16);
+        const char *mant = nullptr;
+        if (q != end && *q == '.') {
+            const char *f = q + 1;
+            while (f != end && isHex(*f))
+                f++;
+            if (q > ds || f > q + 1)
+                mant = f;
+        } else if (q > ds) {
+            mant = q;
+        }
+        if (mant)
+            longer(scanExponent(mant, end, 'p', 'P'), Lexeme::FLTLIT);
+    } else if (*s == '0' && s + 1 != end && (s[1] == 'b' || s[1] == 'B')) {
+        const char *q = s + 2;
+        while (q != end && (*q == '0' || *q == '1'))
+            q++;
+        if (q > s + 2)
+            longer(q, Lexeme::INTLIT02);
+    }
+
+    // 3.14, 3e-9, 3.14e9 (.3 is not a float because of (f0.0))
+    const char *frac = nullptr;
+    if (p != end && *p == '.' && p + 1 != end && isDec(p[1])) {
+        frac = p + 2;
+        while (frac != end && isDec(*frac))
+            frac++;
+        longer(frac, Lexeme::FLTLIT);
+    }
+    longer(scanExponent(p, end, 'e', 'E'), Lexeme::FLTLIT);
+    if (frac)
+        longer(scanExponent(frac, end, 'e', 'E'), Lexeme::FLTLIT);
+
+    // identifiers such as 128x16 (needs a non-zero first digit)
+    if (*s != '0' && p != end && *p == 'x') {
+        const char *q = p + 1;
+        while (q != end && isDec(*q))
+            q++;
+        if (q > p + 1)
+            longer(q, Lexeme::IDENT);
+    }
+
+    return best;
+}
+
+} // namespace
+
+
+void iga::ScanTokens(const std::string &inp, std::vector<Token> &tokens)
+{
+    // the flex scanner reads via c_str() and thus stops at the first NUL
+    const char *base = inp.c_str();
+    const char *end = base + strlen(base);
+
+    // an assembly listing averages well over four characters per token
+    tokens.reserve(tokens.size() + (size_t)(end - base) / 4 + 1);
+
+    uint32_t line = 1;
+    const char *lineStart = base;
+    // The flex driver computes newline columns relative to the previous
+    // NEWLINE token's offset (not the line start); it is reproduced here so
+    // that diagnostics pointing at the end of a line are unchanged.
+    uint32_t prevNewlineOff = 0;
+
+    const char *p = base;
+    while (p != end) {
+        const char *s = p;
+        Lexeme lxm;
+        switch (s_tables.cls[(uint8_t)*p]) {
+        case CC_SPACE:
+            do {
+                p++;
+            } while (p != end && s_tables.cls[(uint8_t)*p] == CC_SPACE);
+            continue;
+        case CC_NEWLINE: {
+            uint32_t off = (uint32_t)(s - base);
+            tokens.emplace_back(
+                Lexeme::NEWLINE, line, off - prevNewlineOff + 1, off, 1);
+            prevNewlineOff = off;
+            line++;
+            lineStart = ++p;
+            continue;
+        }
+        case CC_DIGIT:
+            p = scanNumber(s, end, lxm);
+            break;
+        case CC_IDENT:
+            do {
+                p++;
+            } while (p != end && isIdentChar(*p));
+            lxm = Lexeme::IDENT;
+            break;
+        case CC_PUNCT:
+            lxm = s_tables.punct[(uint8_t)*p++];
+            break;
+        case CC_PREFIX: {
+            const size_t rem = (size_t)(end - s);
+            const char c = *p++;
+            if (c == '(') {
+                lxm = Lexeme::LPAREN;
+                if (rem >= 5 && s[4] == ')') {
+                    if (memcmp(s + 1, "abs", 3) == 0) {
+                        lxm = Lexeme::ABS;
+                        p = s + 5;
+                    } else if (memcmp(s + 1, "sat", 3) == 0) {
+                        lxm = Lexeme::SAT;
+                        p = s + 5;
+                    }
+                }
+            } else if (c == '<') {
+                lxm = Lexeme::LANGLE;
+                if (p != end && *p == '<') {
+                    lxm = Lexeme::LSH;
+                    p++;
+                }
+            } else if (c == '>') {
+                lxm = Lexeme::RANGLE;
+                if (p != end && *p == '>') {
+                    lxm = Lexeme::RSH;
+                    p++;
+                }
+            } else if (p != end && *p == '/') {
+                // EOL comment
+                p = (const char *)memchr(p, '\n', (size_t)(end - p));
+                if (p == nullptr)
+                    p = end;
+                continue;
+            } else if (p != end && *p == '*') {
+                // block comment; an unterminated comment runs to EOF
+                p++;
+                while (p != end) {
+                    if (*p == '\n') {
+                        line++;
+                        lineStart = ++p;
+                    } else if (*p == '*' && p + 1 != end && p[1] == '/') {
+                        p += 2;
+                        break;
+                    } else {
+                        p++;
+                    }
+                }
+                continue;
+            } else {
+                lxm = Lexeme::DIV;
+            }
+            break;
+        }
+        default:
+            lxm = Lexeme::LEXICAL_ERROR;
+            p++;
+            break;
+        }
+        tokens.emplace_back(
+            lxm,
+            line,
+            (uint32_t)(s - lineStart) + 1,
+            (uint32_t)(s - base),
+            (uint32_t)(p - s));
+    }
+
+    // flex reports EOF as a one character token ending at the last column
+    tokens.emplace_back(
+        Lexeme::END_OF_FILE,
+        line,
+        (uint32_t)(end - lineStart),
+        (uint32_t)(end - base),
+        1);
+}
@@ -67,8 +67,11 @@ namespace iga
         BufferedLexer                  m_lexer;
         ErrorHandler                  &m_errorHandler;
     public:
-        Parser(const std::string &inp, ErrorHandler &errHandler)
-            : m_lexer(inp)
+        Parser(
+            const std::string &inp,
+            ErrorHandler &errHandler,
+            bool useFlexLexer = false)
+            : m_lexer(inp, useFlexLexer)
             , m_errorHandler(errHandler)
         {
         }
@@ -33,7 +33,12 @@ namespace iga
 // time.  Alas this lacks some of the APIs that I need to efficiently
 // perform data flow.  Specifically, I need efficient testAny/testAll
 // predicates.
-template <typename I = uint32_t>
+//
+// The set also tracks a window of words [wordsLo, wordsHi) outside of which
+// all words are zero.  Register sets are typically sparse (an operand touches
+// a register or two out of the entire file), so the set operations below only
+// visit the words in the window(s) rather than the whole register file.
+template <typename I = uint64_t>
 class BitSet {
 public:
     static const size_t BITS_PER_WORD = 8 * sizeof(I);
@@ -44,12 +49,13 @@ public:
         , wordsSize(ALIGN_UP_TO(BITS_PER_WORD, numBits) / BITS_PER_WORD)
     {
         words = new I[wordsSize];
-        reset();
+        memset(words, 0, wordsSize * sizeof(I));
     }
     BitSet(const BitSet<I> &rhs)
         : N(rhs.N)
         , wordsSize(ALIGN_UP_TO(BITS_PER_WORD, rhs.N) / BITS_PER_WORD)
-
+        , wordsLo(rhs.wordsLo)
+        , wordsHi(rhs.wordsHi)
     {
         words = new I[wordsSize];
         memcpy_s(
@@ -61,9 +67,12 @@ public:
         : N(copy.N)
         , wordsSize(copy.wordsSize)
         , words(copy.words)
+        , wordsLo(copy.wordsLo)
+        , wordsHi(copy.wordsHi)
     {
         copy.words = nullptr;
         copy.N = copy.wordsSize = 0;
+        copy.wordsLo = copy.wordsHi = 0;
     }
 
     BitSet<I>& operator=(const BitSet<I>& rhs) {
@@ -74,10 +83,19 @@ public:
             N = rhs.N;
             wordsSize = rhs.wordsSize;
             words = new I[wordsSize];
+            memset(words, 0, wordsSize * sizeof(I));
+            wordsLo = wordsHi = 0;
         }
-        memcpy_s(
-            words, wordsSize * sizeof(I),
-            rhs.words, wordsSize * sizeof(I));
+        // only the words either window covers can differ
+        size_t lo = std::min(wordsLo, rhs.wordsLo);
+        size_t hi = std::max(wordsHi, rhs.wordsHi);
+        if (lo < hi) {
+            memcpy_s(
+                words + lo, (wordsSize - lo) * sizeof(I),
+                rhs.words + lo, (hi - lo) * sizeof(I));
+        }
+        wordsLo = rhs.wordsLo;
+        wordsHi = rhs.wordsHi;
         return *this;
     }
 
@@ -92,13 +110,17 @@ public:
     // TODO: remove
     void reset() { clear(); }
 
-    void clear() { memset(words, 0, wordsSize * sizeof(I)); }
+    void clear() {
+        if (wordsLo < wordsHi)
+            memset(words + wordsLo, 0, (wordsHi - wordsLo) * sizeof(I));
+        wordsLo = wordsHi = 0;
+    }
     bool set(size_t off, size_t len = 1, bool val = true); // sets/clears range
     bool test(size_t off) const { return testAny(off, 1); }
     bool testAny(size_t off, size_t len) const;
     bool testAll(size_t off, size_t len) const;
     void containsAll(const BitSet<I> &rhs) const;
-    bool empty() const {return !testAny(0, N);}
+    bool empty() const;
 
     bool intersects(const BitSet<I> &rhs) const;
 
@@ -136,6 +158,18 @@ private:
     size_t N;
     size_t wordsSize;
     I* words;
+    // all words outside [wordsLo, wordsHi) are zero
+    size_t wordsLo = 0, wordsHi = 0;
+
+    void extendWindow(size_t lo, size_t hi) {
+        if (wordsLo == wordsHi) {
+            wordsLo = lo;
+            wordsHi = hi;
+        } else {
+            wordsLo = std::min(wordsLo, lo);
+            wordsHi = std::max(wordsHi, hi);
+        }
+    }
 
     static I makeMask(size_t len) {
         IGA_ASSERT(len <= BITS_PER_WORD,
@@ -143,7 +177,7 @@ private:
         if (len == BITS_PER_WORD) {
             return (I)-1;
         }
-        return (1 << len) - 1;
+        return ((I)1 << len) - 1;
     }
 };
 
@@ -152,6 +186,13 @@ inline bool BitSet<I>::set(size_t off, size_t len, bool val)
 {
     IGA_ASSERT(off >= 0 && off + len <= N,
         "BitSet::set: index out of bounds");
+    if (len == 0) {
+        return false;
+    }
+    if (val) {
+        extendWindow(
+            off / BITS_PER_WORD, (off + len - 1) / BITS_PER_WORD + 1);
+    }
 
     // check the first word (misaligned mask)
     auto w_ix = off / BITS_PER_WORD;
@@ -172,7 +213,7 @@ inline bool BitSet<I>::set(size_t off, size_t len, bool val)
     while (len > 0) {
         w_ix++; // next word
 
-        auto aligned_len = len >= 32 ? 32 : len % BITS_PER_WORD; // last will be <32
+        auto aligned_len = std::min<size_t>(len, BITS_PER_WORD); // last may be partial
         auto aligned_mask = makeMask(aligned_len);
         auto oldWord = words[w_ix];
         if (val) {
@@ -190,9 +231,22 @@ inline bool BitSet<I>::set(size_t off, size_t len, bool val)
 }
 
 
+template <typename I>
+inline bool BitSet<I>::empty() const {
+    for (size_t i = wordsLo; i < wordsHi; i++) {
+        if (words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 template <typename I>
 inline bool BitSet<I>::intersects(const BitSet<I> &rhs) const {
-    for (size_t i = 0; i < wordsSize; i++) {
+    size_t lo = std::max(wordsLo, rhs.wordsLo);
+    size_t hi = std::min(wordsHi, rhs.wordsHi);
+    for (size_t i = lo; i < hi; i++) {
         if (words[i] & rhs.words[i]) {
             return true;
         }
@@ -223,7 +277,7 @@ inline bool BitSet<I>::intersects(
     while (len > 0) {
         w_ix++; // next word
 
-        auto aligned_len = len >= 32 ? 32 : len % BITS_PER_WORD; // last will be <32
+        auto aligned_len = std::min<size_t>(len, BITS_PER_WORD); // last may be partial
         auto aligned_mask = makeMask(aligned_len);
         if ((words[w_ix] & aligned_mask) &
             (rhs.words[w_ix] & aligned_mask)) {
@@ -237,22 +291,16 @@ inline bool BitSet<I>::intersects(
 
 template <typename I>
 inline bool BitSet<I>::equal(const BitSet<I> &rhs) const {
-    bool result = true;
-    for (size_t i = 0; i < wordsSize; i++) {
-        result = (words[i] == rhs.words[i]) ? true : false;
-        if (!result)
-            break;
-    }
-    // padding will remain 0 since both padding are 0's
-    // 0 & 0 is 0 so no need special handling on padding
-    return result;
+    return *this == rhs;
 }
 
 template <typename I>
 inline bool BitSet<I>::andNot(const BitSet<I> &rhs)
 {
     bool changed = false;
-    for (size_t i = 0; i < wordsSize; i++) {
+    size_t lo = std::max(wordsLo, rhs.wordsLo);
+    size_t hi = std::min(wordsHi, rhs.wordsHi);
+    for (size_t i = lo; i < hi; i++) {
         auto old = words[i];
         words[i] &= ~rhs.words[i];
         changed |= (words[i] != old);
@@ -266,8 +314,12 @@ inline bool BitSet<I>::andNot(const BitSet<I> &rhs)
 template <typename I>
 inline bool BitSet<I>::add(const BitSet<I> &rhs)
 {
+    if (rhs.wordsLo == rhs.wordsHi) {
+        return false;
+    }
+    extendWindow(rhs.wordsLo, rhs.wordsHi);
     bool changed = false;
-    for (size_t i = 0; i < wordsSize; i++) {
+    for (size_t i = rhs.wordsLo; i < rhs.wordsHi; i++) {
         auto old = words[i];
         words[i] |= rhs.words[i];
         changed |= (words[i] != old);
@@ -282,8 +334,16 @@ template <typename I>
 inline bool BitSet<I>::intersectInto(
     const BitSet<I> &rhs, BitSet<I> &into) const
 {
+    into.clear();
+    size_t lo = std::max(wordsLo, rhs.wordsLo);
+    size_t hi = std::min(wordsHi, rhs.wordsHi);
+    if (lo >= hi) {
+        return false;
+    }
+    into.wordsLo = lo;
+    into.wordsHi = hi;
     bool notEmpty = false;
-    for (size_t i = 0; i < wordsSize; i++) {
+    for (size_t i = lo; i < hi; i++) {
         into.words[i] = words[i] & rhs.words[i];
         notEmpty |= (into.words[i] != 0);
     }
@@ -312,7 +372,7 @@ inline bool BitSet<I>::testAny(size_t off, size_t len) const
     while (len > 0) {
         w_ix++; // next word
 
-        auto aligned_len = len >= 32 ? 32 : len % BITS_PER_WORD; // last will be <32
+        auto aligned_len = std::min<size_t>(len, BITS_PER_WORD); // last may be partial
         auto aligned_mask = makeMask(aligned_len);
         if (words[w_ix] & aligned_mask) {
             return true;
@@ -345,7 +405,7 @@ inline bool BitSet<I>::testAll(size_t off, size_t len) const
     while (len > 0) {
         w_ix++; // next word
 
-        auto aligned_len = len >= 32 ? 32 : len % BITS_PER_WORD; // last will be <32
+        auto aligned_len = std::min<size_t>(len, BITS_PER_WORD); // last may be partial
         auto aligned_mask = makeMask(aligned_len);
         if ((words[w_ix] & aligned_mask) != aligned_mask) {
             return false;
@@ -365,7 +425,11 @@ bool BitSet<I>::operator==(const BitSet<I> &bs) const
     if (N != bs.N) { // We should not compare BitSets of different size
         return false;
     }
-    return memcmp(&words[0], &bs.words[0], wordsSize * sizeof(I)) == 0;
+    // words outside of both windows are zero in both sets
+    size_t lo = std::min(wordsLo, bs.wordsLo);
+    size_t hi = std::max(wordsHi, bs.wordsHi);
+    return lo >= hi ||
+        memcmp(&words[lo], &bs.words[lo], (hi - lo) * sizeof(I)) == 0;
 }
 
 // C++20 gets std::popcount
@@ -392,7 +456,7 @@ static inline size_t bsPopcount(uint16_t i) {
 template <typename I>
 inline size_t BitSet<I>::cardinality() const {
     size_t n = 0;
-    for (size_t i = 0; i < wordsSize; i++) {
+    for (size_t i = wordsLo; i < wordsHi; i++) {
         n += bsPopcount(words[i]);
     }
     return n;
@@ -16,7 +16,7 @@ SPDX-License-Identifier: MIT
 #include "Block.hpp"
 #include "Instruction.hpp"
 
-#include <set>
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -28,7 +28,21 @@ struct BlockInference
     MemManager *allocator;
 
     std::map<int32_t, Block *> &blockStarts;
-    std::set<int32_t>           instStarts;
+    // Block start PCs as found (unordered, with repeats); blocks are only
+    // allocated once these have been sorted and made unique, which keeps
+    // this linear-ish for kernels with very many labels.
+    std::vector<int32_t>        blockPcs;
+    std::vector<Block *>        blocks; // parallel to the sorted blockPcs
+    std::vector<int32_t>        instStarts;
+
+    struct LabelSource {
+        Instruction *inst;
+        int          srcIx;
+        int32_t      targetPc;
+        LabelSource(Instruction *_inst, int _srcIx, int32_t _targetPc)
+            : inst(_inst), srcIx(_srcIx), targetPc(_targetPc) { }
+    };
+    std::vector<LabelSource> labels;
 
     struct ResolvedTarget {
         Loc     loc; // instruction location
@@ -43,14 +57,10 @@ struct BlockInference
         : allocator(a), blockStarts(bs) { }
 
     Block *getBlock(int32_t pc) {
-        auto itr = blockStarts.find(pc);
-        if (itr == blockStarts.end()) {
-            Block *blk      = new (allocator) Block(pc);
-            blockStarts[pc] = blk;
-            return blk;
-        } else {
-            return itr->second;
-        }
+        auto itr = std::lower_bound(blockPcs.begin(), blockPcs.end(), pc);
+        IGA_ASSERT(itr != blockPcs.end() && *itr == pc,
+            "block start was not recorded");
+        return blocks[itr - blockPcs.begin()];
     }
 
     void replaceNumericLabel(
@@ -82,23 +92,26 @@ struct BlockInference
             } else {
                 resolved.emplace_back(inst->getLoc(), srcIx, targetPc);
             }
-            src.setLabelSource(getBlock(targetPc), src.getType());
+            // the label source is set once the blocks exist
+            blockPcs.push_back(targetPc);
+            labels.emplace_back(inst, srcIx, targetPc);
         }
     }
 
     void run(ErrorHandler &errHandler, int32_t binaryLength, InstList &insts)
     {
         // define start block to ensure at least one block exists
-        (void)getBlock(0);
+        blockPcs.push_back(0);
 
+        instStarts.reserve(insts.size());
         int32_t pc = 0;
         for (Instruction *inst : insts) {
-            instStarts.insert(inst->getPC());
+            instStarts.push_back(inst->getPC());
             int32_t instLen = inst->hasInstOpt(InstOpt::COMPACTED) ? 8 : 16;
             if (inst->getOpSpec().isBranching() || inst->isMovWithLabel()) {
                 // all branching instructions can redirect to next instruction
                 // start a new block after this one
-                (void)getBlock(pc + instLen);
+                blockPcs.push_back(pc + instLen);
                 // replace src0
                 replaceNumericLabel(
                     errHandler,
@@ -119,22 +132,38 @@ struct BlockInference
                 }
             } else if (inst->hasInstOpt(InstOpt::EOT)) {
                 // also treat EOT as the end of a BB
-                (void)getBlock(pc + instLen);
+                blockPcs.push_back(pc + instLen);
             }
             pc += instLen;
         }
 
+        // create the blocks in PC order
+        std::sort(blockPcs.begin(), blockPcs.end());
+        blockPcs.erase(
+            std::unique(blockPcs.begin(), blockPcs.end()), blockPcs.end());
+        blocks.reserve(blockPcs.size());
+        for (int32_t blockPc : blockPcs) {
+            Block *blk = new (allocator) Block(blockPc);
+            blocks.push_back(blk);
+            blockStarts.emplace_hint(blockStarts.end(), blockPc, blk);
+        }
+        for (const LabelSource &ls : labels) {
+            Operand &src = ls.inst->getSource(ls.srcIx);
+            src.setLabelSource(getBlock(ls.targetPc), src.getType());
+        }
+
         // for each block, we need to append the following instructions
         pc               = 0;
-        auto bitr        = blockStarts.begin();
-        Block *currBlock = bitr->second;
-        bitr++;
+        auto bitr        = blocks.begin();
+        auto pcitr       = blockPcs.begin();
+        Block *currBlock = *bitr++;
+        pcitr++;
 
         for (Instruction *inst : insts) {
             int32_t instLen = inst->hasInstOpt(InstOpt::COMPACTED) ? 8 : 16;
-            if (bitr != blockStarts.end() && pc >= bitr->first) {
-                currBlock = bitr->second;
-                bitr++;
+            if (bitr != blocks.end() && pc >= *pcitr) {
+                currBlock = *bitr++;
+                pcitr++;
             }
 
             currBlock->appendInstruction(inst);
@@ -142,9 +171,12 @@ struct BlockInference
             pc += instLen;
         }
 
+        if (!std::is_sorted(instStarts.begin(), instStarts.end()))
+            std::sort(instStarts.begin(), instStarts.end());
         for (const ResolvedTarget &rt : resolved) {
             if (rt.targetPc != binaryLength && // EOF is also a valid target
-                instStarts.find(rt.targetPc) == instStarts.end())
+                !std::binary_search(
+                    instStarts.begin(), instStarts.end(), rt.targetPc))
             {
                 std::stringstream ss;
                 ss << "src" << rt.srcIx <<
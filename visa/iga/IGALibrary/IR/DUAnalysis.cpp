@@ -621,12 +621,17 @@ struct DepAnalysisComputer
     // outputs
     DepAnalysis                     &results;
 
+    // scratch for extendLivePathBackwards; this is called for every live
+    // path at every instruction, so we avoid building a RegSet each time
+    RegSet                           iOverlap;
+
     DepAnalysisComputer(
         Kernel *_k,
         DepAnalysis &_results)
         : model(_k->getModel())
         , k(_k)
         , results(_results)
+        , iOverlap(_k->getModel())
     {
         sanityCheckIR(k); // should nop in release
 
@@ -938,10 +943,10 @@ struct DepAnalysisComputer
         // don't want to accidentially subtract out this def
         lp.updateForPredicateRedefs(iKills);
 
-        RegSet iOverlap(model);
-
         bool matchesPredication = lp.matchesPredication(iPred, iPredInv);
-        if (matchesPredication) {
+        if (!matchesPredication) {
+            iOverlap.reset();
+        } else {
             bool overlapNotEmpty = lp.live.intersectInto(iKills, iOverlap);
             // overlap are now the bytes we write that intersect with this live
             // range; if not empty, this constitutes a new D/U pair
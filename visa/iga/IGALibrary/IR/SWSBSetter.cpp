@@ -576,14 +576,16 @@ void SWSBAnalyzer::clearBuckets(DepSet* input, DepSet* output) {
     if (input->getDepClass() != DEP_CLASS::IN_ORDER)
         return;
 
+    DEP_PIPE new_pipe = input->getDepPipe();
+    auto &pipeTracker = m_distanceTracker[new_pipe];
     if (m_initPoint) {
-        m_distanceTracker.emplace_back(input, output);
+        pipeTracker.emplace_back(input, output);
         m_initPoint = false;
 
     }
     else {
         // add DepSet to m_distanceTracker
-        m_distanceTracker.emplace_back(input, output);
+        pipeTracker.emplace_back(input, output);
 
         auto get_depset_id = [&](DEP_PIPE pipe_type, DepSet& dep_set) {
             if (getNumOfDistPipe() == 1)
@@ -608,27 +610,22 @@ void SWSBAnalyzer::clearBuckets(DepSet* input, DepSet* output) {
             return m_LatencyInOrderPipe;
         };
 
-        DEP_PIPE new_pipe = input->getDepPipe();
         // max B2B latency of thie pipe
         size_t max_dis = get_latency(new_pipe);
         // Remove nodes from the Tracker if the latency is already satified
-        m_distanceTracker.remove_if(
-            [=](const distanceTrackerNode& node) {
-                // bypass nodes those are not belong to the same pipe
-                if (node.input->getDepPipe() != new_pipe)
-                    return false;
-
-                // if the distance >= max_latency, clear buckets for corresponding
-                // input and output Dependency
-                size_t new_id = get_depset_id(new_pipe, *input);
-                if ((new_id - get_depset_id(new_pipe, *node.input)) >= max_dis) {
-                    clearDepBuckets(*node.input);
-                    clearDepBuckets(*node.output);
-                    return true;
-                }
-                return false;
-            }
-        );
+        // (ids are increasing within the pipe, so stop at the first node that
+        // is still within the latency window)
+        size_t new_id = get_depset_id(new_pipe, *input);
+        while (!pipeTracker.empty()) {
+            const distanceTrackerNode &node = pipeTracker.front();
+            // if the distance >= max_latency, clear buckets for corresponding
+            // input and output Dependency
+            if ((new_id - get_depset_id(new_pipe, *node.input)) < max_dis)
+                break;
+            clearDepBuckets(*node.input);
+            clearDepBuckets(*node.output);
+            pipeTracker.pop_front();
+        }
     }
 }
 
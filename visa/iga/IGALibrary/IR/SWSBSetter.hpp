@@ -16,6 +16,9 @@ SPDX-License-Identifier: MIT
 #include "../ErrorHandler.hpp"
 #include "RegDeps.hpp"
 
+#include <deque>
+#include <map>
+
 namespace iga
 {
     // Bucket represents a GRF and maps to all instructions that access it
@@ -172,6 +175,8 @@ namespace iga
         // m_distanceTracker - Track the DepSet of in-order instructions to see if their latency
         // is satisfied. If the distance to current instruction is larger then the latency, then
         // we no need to track the dependency anymore, remove the node from m_distanceTracker
+        // The nodes are kept per pipe in program order; since the in-order ids grow
+        // monotonically within a pipe, the satisfied nodes are always at the front.
         struct distanceTrackerNode {
             distanceTrackerNode(DepSet *in, DepSet *out)
                 : input(in), output(out)
@@ -179,7 +184,7 @@ namespace iga
             DepSet *input;
             DepSet *output;
         };
-        std::list<distanceTrackerNode> m_distanceTracker;
+        std::map<DEP_PIPE, std::deque<distanceTrackerNode>> m_distanceTracker;
 
         bool m_initPoint;
 
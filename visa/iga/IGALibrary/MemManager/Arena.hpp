@@ -174,6 +174,21 @@ private:
 
     void FreeArenas();
 
+    // Moves all of other's arenas behind our current one (which keeps serving
+    // allocations) and gives other a fresh arena.
+    void AdoptArenas(ArenaManager &other)
+    {
+        ArenaHeader *last = other._arenas;
+        if (last == nullptr)
+            return;
+        while (last->_nextArena != nullptr)
+            last = last->_nextArena;
+        last->_nextArena = _arenas->_nextArena;
+        _arenas->_nextArena = other._arenas;
+        other._arenas = nullptr;
+        other.CreateArena(other._defaultArenaSize);
+    }
+
     // Data
 
     ArenaHeader  *_arenas;
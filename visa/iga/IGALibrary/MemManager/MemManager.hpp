@@ -28,6 +28,14 @@ public:
         return _arenaManager.AllocDataSpace(size);
     }
 
+    // Takes over all memory allocated from another manager so that objects
+    // living there share this manager's lifetime (e.g. instructions decoded
+    // into a per-thread kernel).  The other manager is left empty.
+    void adopt(MemManager &other)
+    {
+        _arenaManager.AdoptArenas(other._arenaManager);
+    }
+
 private:
     ArenaManager   _arenaManager;
 
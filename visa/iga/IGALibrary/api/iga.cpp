@@ -354,6 +354,8 @@ public:
         ParseOpts popts(m_model);
         popts.supportLegacyDirectives =
             (aopts.syntax_opts & IGA_SYNTAX_OPT_LEGACY_SYNTAX) != 0;
+        popts.useFlexLexer =
+            (aopts.syntax_opts & IGA_SYNTAX_OPT_FLEX_LEXER) != 0;
         Kernel *pKernel = iga::ParseGenKernel(m_model, inp, errHandler, popts);
         if (pKernel && !errHandler.hasErrors() && aopts.enabled_warnings) {
             // check semantics if we parsed without error && they haven't
@@ -483,7 +485,8 @@ public:
         k = nullptr;
         checkForLegacyFields(dopts, errHandler);
         DecoderOpts dopts2(
-            (dopts.formatting_opts & IGA_FORMATTING_OPT_NUMERIC_LABELS) != 0);
+            (dopts.formatting_opts & IGA_FORMATTING_OPT_NUMERIC_LABELS) != 0,
+            (dopts.decoder_opts & IGA_DECODING_OPT_PARALLEL) != 0);
         if ((dopts.decoder_opts & IGA_DECODING_OPT_NATIVE) == 0) {
             if (!iga::ged::IsDecodeSupported(m_model,dopts2)) {
                 return IGA_UNSUPPORTED_PLATFORM;
@@ -561,6 +564,46 @@ public:
     }
 
 
+    iga_status_t disassembleStreaming(
+        iga_disassemble_options_t &dopts,
+        const void *bits,
+        uint32_t bitsLen,
+        const char *(*formatLbl)(int32_t, void *),
+        void *formatLblEnv,
+        char *buffer,
+        size_t bufferSize,
+        iga_disassemble_inst_callback_t emitInst,
+        void *emitInstEnv)
+    {
+        iga::Kernel *k = nullptr;
+        iga::ErrorHandler errHandler;
+        iga_status_t st = disassembleKernel(
+            errHandler,
+            dopts,
+            bits,
+            bitsLen,
+            k);
+        if (k != nullptr) {
+            FormatOpts fopts = formatterOpts(dopts, formatLbl, formatLblEnv);
+            DepAnalysis la;
+            if (dopts.formatting_opts & IGA_FORMATTING_OPT_PRINT_DEFS) {
+                la = ComputeDepAnalysis(k);
+                fopts.liveAnalysis = &la;
+            }
+            FormatKernelStreaming(
+                errHandler, fopts, *k, bits,
+                buffer, bufferSize, emitInst, emitInstEnv);
+            delete k;
+        }
+
+        st = translateDiagnostics(errHandler);
+        if (errHandler.hasErrors()) {
+            return IGA_DECODE_ERROR;
+        }
+        return st;
+    }
+
+
     iga_status_t disassembleInstruction(
         iga_disassemble_options_t &dopts,
         const void *bits,
@@ -793,6 +836,44 @@ iga_status_t  iga_context_disassemble(
         fmt_label_ctx,
         kernel_text);
 }
+iga_status_t  iga_context_disassemble_streaming(
+    iga_context_t ctx,
+    const iga_disassemble_options_t *dopts,
+    const void *input,
+    uint32_t input_size,
+    const char * (*fmt_label_name)(int32_t, void *),
+    void *fmt_label_ctx,
+    char *buffer,
+    size_t buffer_size,
+    iga_disassemble_inst_callback_t emit_inst,
+    void *emit_inst_ctx)
+{
+    RETURN_INVALID_ARG_ON_NULL(ctx);
+    RETURN_INVALID_ARG_ON_NULL(dopts);
+    if (input == nullptr && input_size != 0)
+        return IGA_INVALID_ARG;
+    if (buffer == nullptr && buffer_size != 0)
+        return IGA_INVALID_ARG;
+    RETURN_INVALID_ARG_ON_NULL(emit_inst);
+    if (dopts->cb > sizeof(*dopts)) {
+        return IGA_VERSION_ERROR;
+    }
+    iga_disassemble_options_t doptsInternal = IGA_DISASSEMBLE_OPTIONS_INIT();
+    memcpy_s(&doptsInternal, dopts->cb, dopts, dopts->cb);
+
+    CAST_CONTEXT(ctx_obj, ctx);
+    return ctx_obj->disassembleStreaming(
+        doptsInternal,
+        input,
+        input_size,
+        fmt_label_name,
+        fmt_label_ctx,
+        buffer,
+        buffer_size,
+        emit_inst,
+        emit_inst_ctx);
+}
+
 iga_status_t  iga_disassemble(
     iga_context_t ctx,
     const iga_disassemble_options_t *dopts,
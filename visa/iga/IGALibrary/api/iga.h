@@ -298,6 +298,8 @@ static_assert(sizeof(iga_assemble_options_t) == 8*4,
 #define IGA_SYNTAX_OPT_LEGACY_SYNTAX   0x00000001u
 /* enables syntax extensions */
 #define IGA_SYNTAX_OPT_EXTENSIONS      0x00000002u
+/* scans with the legacy flex-generated lexer (slower; for comparison) */
+#define IGA_SYNTAX_OPT_FLEX_LEXER      0x00000004u
 
 
 /*
@@ -449,6 +451,9 @@ static_assert(sizeof(iga_disassemble_options_t) == 5*4,
 
 /* uses the native decoder for decoding the kernel */
 #define IGA_DECODING_OPT_NATIVE   0x00000001u
+/* decodes large kernels in chunks on multiple threads (GED decoder only);
+ * the resulting kernel is identical to a sequential decode */
+#define IGA_DECODING_OPT_PARALLEL 0x00000002u
 /* just the default decoding opts */
 #define IGA_DECODING_OPTS_DEFAULT \
     (0u)
@@ -507,6 +512,71 @@ IGA_API  iga_status_t  iga_disassemble(
     char **kernel_text);
 
 
+/*
+ * Receives the text of one instruction from
+ * iga_context_disassemble_streaming.
+ *
+ * PARAMETERS:
+ *  pc              the PC of the instruction (relative to the start of the
+ *                  disassembly)
+ *  text            the instruction text including any block label that
+ *                  precedes the instruction and the trailing newline; this
+ *                  is NOT NUL-terminated and is only valid until the
+ *                  callback returns (the buffer is reused)
+ *  text_len        the length of 'text' in bytes
+ *  env             the 'emit_inst_ctx' passed to the disassembly call
+ */
+typedef void (*iga_disassemble_inst_callback_t)(
+    int32_t pc,
+    const char *text,
+    size_t text_len,
+    void *env);
+
+/*
+ * Disassembles kernel bits an instruction at a time, passing each
+ * instruction's text to a callback rather than building the whole listing.
+ * Concatenating the text passed to 'emit_inst' yields the same output as
+ * iga_context_disassemble.  JSON output (IGA_FORMATTING_OPT_PRINT_JSON) is
+ * passed to the callback as a single piece.
+ *
+ * PARAMETERS:
+ *  ctx             an iga context
+ *  dopts           the disassemble options
+ *  input           the instructions to disassemble
+ *  input_size      the size of the 'input' in bytes
+ *  fmt_label_name  optional label callback (see iga_context_disassemble)
+ *  fmt_label_ctx   a callback context (environment) forwarded to 'fmt_label'
+ *  buffer          a caller-owned buffer each instruction is formatted into;
+ *                  it is reused for every instruction and may be NULL only
+ *                  if 'buffer_size' is 0; text that exceeds it goes to an
+ *                  internal buffer that is likewise reused
+ *  buffer_size     the size of 'buffer' in bytes; 256 comfortably holds
+ *                  typical instructions
+ *  emit_inst       the callback receiving each instruction's text
+ *  emit_inst_ctx   a callback context (environment) forwarded to 'emit_inst'
+ *
+ * RETURNS:
+ *  IGA_SUCCESS         upon successful disassembly; 'iga_get_warnings' may
+ *                      contain warning diagnostics even upon success
+ *  IGA_INVALID_ARG     if a required argument is NULL
+ *  IGA_INVALID_OBJECT  if ctx has already been destroyed
+ *  IGA_DECODE_ERROR    upon failure to decode error; specific error messages
+ *                      may be retrieved via 'iga_context_get_errors'; the
+ *                      callback will have seen the partially decoded kernel
+ */
+IGA_API  iga_status_t  iga_context_disassemble_streaming(
+    iga_context_t ctx,
+    const iga_disassemble_options_t *dopts,
+    const void *input,
+    uint32_t input_size,
+    const char *(*fmt_label_name)(int32_t, void *),
+    void *fmt_label_ctx,
+    char *buffer,
+    size_t buffer_size,
+    iga_disassemble_inst_callback_t emit_inst,
+    void *emit_inst_ctx);
+
+
 /*
  * Disassembles a single instruction.
  *
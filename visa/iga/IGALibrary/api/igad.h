@@ -85,6 +85,19 @@ typedef iga_status_t(CDECLATTRIBUTE * pIGADisassemble)(
     void *fmt_label_ctx,
     char **kernel_text);
 
+#define IGA_CONTEXT_DISASSEMBLE_STREAMING_STR "iga_context_disassemble_streaming"
+typedef iga_status_t(CDECLATTRIBUTE * pIGAContextDisassembleStreaming)(
+    iga_context_t ctx,
+    const iga_disassemble_options_t *opts,
+    const void *input,
+    uint32_t input_size,
+    const char *(*fmt_label_name)(int32_t, void *),
+    void *fmt_label_ctx,
+    char *buffer,
+    size_t buffer_size,
+    iga_disassemble_inst_callback_t emit_inst,
+    void *emit_inst_ctx);
+
 #define IGA_CONTEXT_DISASSEMBLE_INSTRUCTION_STR "iga_context_disassemble_instruction"
 typedef iga_status_t(CDECLATTRIBUTE * pIGAContextDisassembleInstruction)(
     iga_context_t ctx,
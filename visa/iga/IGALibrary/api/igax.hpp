@@ -121,6 +121,15 @@ class Context {
         const void *bits,
         const size_t bitsLen,
         const iga_disassemble_options_t &opts = IGA_DISASSEMBLE_OPTIONS_INIT());
+    // Disassembles a sequence of bits an instruction at a time, passing
+    // each instruction's text to a callback instead of building a string
+    // (see iga_context_disassemble_streaming); returns the warnings
+    std::vector<Diagnostic> disassembleStreaming(
+        const void *bits,
+        const size_t bitsLen,
+        iga_disassemble_inst_callback_t emitInst,
+        void *emitInstEnv,
+        const iga_disassemble_options_t &opts = IGA_DISASSEMBLE_OPTIONS_INIT());
 };
 
 // parent class for all IGA API errors
@@ -402,6 +411,46 @@ inline DisResult Context::disassembleToString(
     return result;
 }
 
+inline std::vector<Diagnostic> Context::disassembleStreaming(
+    const void *bits,
+    const size_t bitsLen,
+    iga_disassemble_inst_callback_t emitInst,
+    void *emitInstEnv,
+    const iga_disassemble_options_t &opts)
+{
+    char buffer[256];
+    iga_status_t st = iga_context_disassemble_streaming(
+        context,
+        &opts,
+        bits,
+        (uint32_t)bitsLen,
+        nullptr,
+        nullptr,
+        buffer,
+        sizeof(buffer),
+        emitInst,
+        emitInstEnv);
+    if (st != IGA_SUCCESS) {
+        // the text has already been streamed out
+        std::string text_str;
+        if (st == IGA_UNSUPPORTED_PLATFORM) {
+            std::vector<Diagnostic> errs;
+            throw DisassembleError(st,
+                "iga_context_disassemble_streaming",
+                errs, bits, bitsLen, text_str);
+        }
+        std::vector<Diagnostic> errs = igax::getErrors(context);
+        if (st == IGA_DECODE_ERROR) {
+            throw DecodeError("iga_context_disassemble_streaming",
+                errs, bits, bitsLen, text_str);
+        } else {
+            throw DisassembleError(st, "iga_context_disassemble_streaming",
+                errs, bits, bitsLen, text_str);
+        }
+    }
+    return getWarnings(context);
+}
+
 inline void Error::emit(std::ostream &os) const {
     os << api << ": " << iga_status_to_string(status);
 }
@@ -93,6 +93,8 @@ public:
     static constexpr const char* numGRFSpillStr() { return "NumGRFSpill"; };
     static constexpr const char* numGRFFillStr() { return "NumGRFFill"; };
     static constexpr const char* numCyclesStr() { return "NumCycles"; };
+    static constexpr const char* debugInfoBytesStr() { return "DebugInfoBytes"; };
+    static constexpr const char* defUseBytesStr() { return "DefUseChainBytes"; };
 
 
     // Statistic collection is disabled by default.
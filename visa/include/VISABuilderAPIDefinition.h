@@ -15,6 +15,7 @@ SPDX-License-Identifier: MIT
 #include "JitterDataStruct.h"
 
 #include "visa/include/RelocationInfo.h"
+#include "visa/include/VISADebugInfo.h"
 
 class VISAKernel
 {
@@ -760,6 +761,13 @@ public:
     /// buffer must be de-allocated using freeBLock API.
     VISA_BUILDER_API virtual int GetGenxDebugInfo(void *&buffer, unsigned int &size) const = 0;
 
+    /// TakeGenxDebugInfo -- moves the GEN debug info into <info> without going
+    /// through the binary format returned by GetGenxDebugInfo.
+    /// This function may only be called after Compile() is called
+    /// GetGenxDebugInfo returns an empty buffer afterwards unless it was
+    /// called before.
+    VISA_BUILDER_API virtual int TakeGenxDebugInfo(vISA::GenDebugInfo &info) = 0;
+
     /// GetGenRelocEntryBuffer -- allocate and return a buffer of all GenRelocEntry that are created by vISA
     VISA_BUILDER_API virtual int GetGenRelocEntryBuffer(void *&buffer, unsigned int &byteSize, unsigned int &numEntries) = 0;
 
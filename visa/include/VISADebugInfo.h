@@ -0,0 +1,132 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+/*  ---------------------------------------------------------------------------
+**
+**  File Name     : VISADebugInfo.h
+**
+**  Abastract     : This file contains the in-memory form of the GEN debug
+**                  info (variable allocations, live intervals, call frame
+**                  info) that vISA hands over to the compiler. The binary
+**                  debug info emitted for offline tools is a serialization
+**                  of these structures.
+**  -------------------------------------------------------------------------- */
+#ifndef VISA_DEBUG_INFO_H
+#define VISA_DEBUG_INFO_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vISA {
+
+/// GenDbgMapping - Location of a value, either a register or a memory slot.
+/// Which of the two is valid is given by the owner of the mapping.
+struct GenDbgMapping {
+    // Register location, for GRF the sub-register number is in bytes
+    uint16_t regNum = 0;
+    uint16_t subRegNum = 0;
+    // Memory location, the offset is absolute when isAbs is set and
+    // BE_FP relative otherwise
+    bool     isAbs = false;
+    int32_t  memoryOffset = 0;
+};
+
+/// GenDbgVarAlloc - Virtual register file of a variable and the physical
+/// location RA assigned to it
+struct GenDbgVarAlloc {
+    enum VirtualVarType : uint8_t {
+        VirTypeAddress = 0,
+        VirTypeFlag    = 1,
+        VirTypeGRF     = 2
+    };
+    enum PhysicalVarType : uint8_t {
+        PhyTypeAddress = 0,
+        PhyTypeFlag    = 1,
+        PhyTypeGRF     = 2,
+        PhyTypeMemory  = 3
+    };
+    uint8_t       virtualType = VirTypeGRF;
+    uint8_t       physicalType = PhyTypeGRF;
+    GenDbgMapping mapping;
+
+    bool isMemory() const { return physicalType == PhyTypeMemory; }
+};
+
+/// GenDbgLiveInterval - A range over which a variable lives in one location.
+/// The range is in vISA indices for variables and subroutine return values
+/// and in GEN byte offsets for the call frame info.
+struct GenDbgLiveInterval {
+    uint32_t       start = 0;
+    uint32_t       end = 0;
+    GenDbgVarAlloc var;
+};
+
+struct GenDbgVarInfo {
+    std::string                     name;
+    std::vector<GenDbgLiveInterval> lrs;
+};
+
+struct GenDbgSubroutineInfo {
+    std::string                     name;
+    uint32_t                        startVISAIndex = 0;
+    uint32_t                        endVISAIndex = 0;
+    std::vector<GenDbgLiveInterval> retval;
+};
+
+/// GenDbgRegInfoMapping - Where a part of a GRF is saved to
+struct GenDbgRegInfoMapping {
+    uint16_t      srcRegOff = 0;
+    uint16_t      numBytes = 0;
+    bool          dstInReg = false;
+    GenDbgMapping dst;
+};
+
+/// GenDbgPhyRegSaveInfoPerIP - Registers saved as of a GEN IP
+struct GenDbgPhyRegSaveInfoPerIP {
+    uint32_t                          genIPOffset = 0;
+    std::vector<GenDbgRegInfoMapping> data;
+};
+
+struct GenDbgCallFrameInfo {
+    uint16_t                               frameSize = 0;
+    bool                                   befpValid = false;
+    std::vector<GenDbgLiveInterval>        befp;
+    bool                                   callerbefpValid = false;
+    std::vector<GenDbgLiveInterval>        callerbefp;
+    bool                                   retAddrValid = false;
+    std::vector<GenDbgLiveInterval>        retAddr;
+    std::vector<GenDbgPhyRegSaveInfoPerIP> calleeSaveEntry;
+    std::vector<GenDbgPhyRegSaveInfoPerIP> callerSaveEntry;
+};
+
+/// GenDbgCompiledObj - Debug info of a kernel or of a stack call function.
+/// The GEN offsets of CISAOffsetMap and CISAIndexMap are relative to
+/// relocOffset, the offset of the object in the kernel binary.
+struct GenDbgCompiledObj {
+    std::string                                      kernelName;
+    uint32_t                                         relocOffset = 0;
+    std::vector<std::pair<uint32_t, uint32_t>>       CISAOffsetMap;
+    std::vector<std::pair<uint32_t, uint32_t>>       CISAIndexMap;
+    std::vector<GenDbgVarInfo>                       Vars;
+    std::vector<GenDbgSubroutineInfo>                subs;
+    GenDbgCallFrameInfo                              cfi;
+};
+
+/// GenDebugInfo - Debug info of a kernel and of the stack call functions
+/// compiled with it, the kernel comes first
+struct GenDebugInfo {
+    std::vector<GenDbgCompiledObj> compiledObjs;
+
+    bool empty() const { return compiledObjs.empty(); }
+};
+
+} // namespace vISA
+
+#endif // VISA_DEBUG_INFO_H